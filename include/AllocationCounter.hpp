@@ -0,0 +1,7 @@
+#pragma once
+
+#include <cstdint>
+
+// Licznik alokacji sterty na biezacym watku (globalny operator new).
+// Dziala tylko w budowie z SNAKE_COUNT_ALLOCATIONS, w przeciwnym razie zwraca 0.
+std::uint64_t threadAllocationCount();
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+// Proste zapisy binarne (kolejnosc bajtow gospodarza) dla powtorek i zapisow stanu.
+
+template <typename T>
+void writeValue(std::ostream& output, const T& value)
+{
+    static_assert(std::is_trivially_copyable_v<T>);
+    output.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+template <typename T>
+T readValue(std::istream& input)
+{
+    static_assert(std::is_trivially_copyable_v<T>);
+    T value{};
+    input.read(reinterpret_cast<char*>(&value), sizeof(value));
+    return value;
+}
+
+template <typename T>
+void appendValue(std::vector<std::byte>& output, const T& value)
+{
+    static_assert(std::is_trivially_copyable_v<T>);
+    const auto* bytes = reinterpret_cast<const std::byte*>(&value);
+    output.insert(output.end(), bytes, bytes + sizeof(value));
+}
+
+template <typename T>
+void appendValues(std::vector<std::byte>& output, std::span<const T> values)
+{
+    static_assert(std::is_trivially_copyable_v<T>);
+    const auto* bytes = reinterpret_cast<const std::byte*>(values.data());
+    output.insert(output.end(), bytes, bytes + values.size_bytes());
+}
+
+// Czytanie kolejnych wartosci z bufora; rzuca wyjatek przy koncu danych.
+class ByteReader
+{
+public:
+    explicit ByteReader(std::span<const std::byte> data)
+        : data_(data)
+    {
+    }
+
+    template <typename T>
+    T read()
+    {
+        T value{};
+        readInto(std::span<T>(&value, 1));
+        return value;
+    }
+
+    template <typename T>
+    void readInto(std::span<T> values)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        if (values.size_bytes() > data_.size() - offset_)
+        {
+            throw std::invalid_argument("Unexpected end of binary data");
+        }
+        std::memcpy(values.data(), data_.data() + offset_, values.size_bytes());
+        offset_ += values.size_bytes();
+    }
+
+    std::size_t remaining() const
+    {
+        return data_.size() - offset_;
+    }
+
+private:
+    std::span<const std::byte> data_;
+    std::size_t offset_{0};
+};
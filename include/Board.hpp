@@ -2,7 +2,14 @@
 
 #include "Types.hpp"
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
 // Parametry planszy i prosta walidacja polozenia.
+// Pola sa numerowane liniowo z ramka szerokosci 1 wokol planszy, dzieki czemu
+// sasiad dowolnego pola planszy ma poprawny indeks, a test granic to jeden odczyt.
 class Board
 {
 public:
@@ -13,7 +20,43 @@ public:
     // Sprawdza czy pozycja miesci sie w planszy.
     bool inside(const GridPos& pos) const;
 
+    // Czy waz moze wejsc na pole (ramka i sciany sa zablokowane).
+    bool passable(Cell cell) const
+    {
+        return ((blocked_[cell >> 6] >> (cell & 63)) & 1) == 0;
+    }
+    // Stawia sciane na polu planszy.
+    void setWall(const GridPos& pos);
+    // Liczba pol planszy bez scian.
+    std::size_t passableCount() const;
+    bool hasWalls() const;
+
+    // Liczba indeksow razem z ramka (rozmiar tablic indeksowanych Cell).
+    std::size_t cellCount() const;
+    Cell cell(const GridPos& pos) const;
+    GridPos position(Cell cell) const;
+
+    // Przesuniecie indeksu dla kierunku.
+    std::int32_t step(Direction direction) const
+    {
+        return steps_[static_cast<std::size_t>(direction)];
+    }
+    const std::array<std::int32_t, 4>& steps() const;
+
 private:
+    void block(Cell cell);
+
     int width_{};
     int height_{};
+    int stride_{};
+    std::array<std::int32_t, 4> steps_{};
+    // Upakowane bity zablokowanych pol, po 64 pola na slowo.
+    std::vector<std::uint64_t> blocked_;
+    std::size_t passableCount_{};
 };
+
+// Sasiad pola w danym kierunku (arytmetyka modulo 2^32 dla ujemnych przesuniec).
+inline Cell neighbor(Cell cell, std::int32_t step)
+{
+    return cell + static_cast<Cell>(step);
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "Simulation.hpp"
+#include "SpaceAnalyzer.hpp"
+
+#include <SFML/Graphics.hpp>
+
+#include <optional>
+#include <span>
+#include <vector>
+
+// Kolor jedzenia lub bonusu (wspolny dla widokow gry).
+sf::Color itemColor(ItemKind kind);
+
+// Prostokat jako dwa trojkaty, do tablic wierzcholkow rysowanych jednym wywolaniem.
+void appendQuad(sf::VertexArray& vertices, sf::Vector2f topLeft, sf::Vector2f size, sf::Color color);
+void appendQuad(std::vector<sf::Vertex>& vertices, sf::Vector2f topLeft, sf::Vector2f size, sf::Color color);
+
+// Rysuje weza i przedmioty na dowolnym celu SFML (okno lub tekstura).
+class BoardRenderer
+{
+public:
+    explicit BoardRenderer(int tileSize);
+
+    void draw(sf::RenderTarget& target, const Simulation& simulation);
+    // Podpowiedz zagrozen: smiertelne ruchy, ruchy w pulapke i punkty przeciecia obszaru.
+    void drawDanger(sf::RenderTarget& target,
+                    const Simulation& simulation,
+                    const SpaceReport& report,
+                    std::span<const Cell> chokePoints);
+
+private:
+    // Sciany sie nie zmieniaja, wiec rysujemy je raz do tekstury tla.
+    void buildBackground(const Board& board);
+
+    int tileSize_{};
+    sf::RectangleShape snakeShape_;
+    // Wszystkie przedmioty jednym wywolaniem rysowania (na duzej planszy moga ich byc tysiace).
+    sf::VertexArray itemTiles_{sf::PrimitiveType::Triangles};
+    sf::VertexArray dangerTiles_{sf::PrimitiveType::Triangles};
+
+    const Board* backgroundBoard_{nullptr};
+    sf::RenderTexture background_;
+    std::optional<sf::Sprite> backgroundSprite_;
+};
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "Simulation.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+// Ustawienia sterowania przez zewnetrznego bota.
+struct BotOptions
+{
+    // Pusta sciezka oznacza stdin/stdout, inaczej gniazdo Unix, na ktorym gra czeka na bota.
+    std::filesystem::path socket;
+    // Liczba tikow na jedna wymiane wiadomosci (1 do maxBatch).
+    int batch{1};
+    static constexpr int maxBatch = 4096;
+};
+
+// Tekstowy protokol bota: gra wysyla stan i zmiany po kazdym tiku,
+// bot odpowiada jedna linia z ruchami na kolejne tiki (opis w README).
+// Dziala na systemach z deskryptorami plikow POSIX.
+class BotLink
+{
+public:
+    explicit BotLink(const BotOptions& options);
+    ~BotLink();
+
+    BotLink(const BotLink&) = delete;
+    BotLink& operator=(const BotLink&) = delete;
+
+    // Wysyla pelny stan nowej gry (plansza, sciany, waz, jedzenie).
+    void startGame(const Simulation& simulation);
+    // Ruch na nastepny tik; gdy kolejka ruchow jest pusta, wysyla zmiany i czeka na bota.
+    // Kropka w odpowiedzi zostawia kierunek current. Zwraca nullopt, gdy bot zakonczyl polaczenie.
+    std::optional<Direction> nextMove(Direction current);
+    // Dopisuje zmiane stanu po tiku (wysylana razem z prosba o kolejne ruchy).
+    void recordTick(const Simulation& simulation, StepResult result);
+
+    // Czasy odpowiedzi bota na stderr.
+    void report() const;
+
+private:
+    void append(std::string_view text);
+    void appendNumber(std::int64_t value);
+    void appendPosition(const Board& board, Cell cell);
+    void flush();
+    // Czyta jedna linie odpowiedzi; false przy koncu polaczenia.
+    bool readLine(std::string_view& line);
+    void recordLatency(std::uint64_t micros);
+
+    int input_{-1};
+    int output_{-1};
+    int listener_{-1};
+    std::filesystem::path socketPath_;
+    int batch_{1};
+
+    std::vector<char> outBuffer_;
+    // Miesci najdluzsza linie ruchow razem z reszta poprzedniego odczytu.
+    std::array<char, 2 * BotOptions::maxBatch + 2> inBuffer_{};
+    std::size_t inBegin_{0};
+    std::size_t inEnd_{0};
+
+    // Ruchy z ostatniej odpowiedzi (kropka = bez zmiany kierunku).
+    std::array<char, BotOptions::maxBatch> moves_{};
+    std::size_t moveCount_{0};
+    std::size_t nextMove_{0};
+
+    // Histogram czasow odpowiedzi w przedzialach potegi dwojki mikrosekund.
+    std::array<std::uint64_t, 64> latencyBuckets_{};
+    std::uint64_t rounds_{0};
+    std::uint64_t ticks_{0};
+    std::uint64_t latencySum_{0};
+    std::uint64_t latencyMax_{0};
+};
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "Replay.hpp"
+#include "Simulation.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Stan sesji okna zapisywany razem ze stanem symulacji (wznowiona gra zawsze czeka w pauzie).
+struct SessionState
+{
+    Direction pendingDirection{Direction::Right};
+    std::string playerName;
+};
+
+// Wczytany zapis stanu; symulacja jest odtwarzana na miejscu.
+struct LoadedCheckpoint
+{
+    SessionState session;
+    Replay replay;
+};
+
+// Zapis gry w tle. Plik zapisu zawiera tylko biezacy stan symulacji, wiec jego rozmiar
+// zalezy od dlugosci weza, a nie od dlugosci gry. Powtorka idzie do osobnego dziennika,
+// do ktorego dopisujemy tylko tiki i klatki kluczowe od poprzedniego zapisu.
+// Pliki sa zapisywane atomowo (dziennik przed plikiem tymczasowym, fsync, rename).
+class CheckpointWriter
+{
+public:
+    explicit CheckpointWriter(std::filesystem::path path);
+    // Czeka na zalegly zapis.
+    ~CheckpointWriter();
+
+    CheckpointWriter(const CheckpointWriter&) = delete;
+    CheckpointWriter& operator=(const CheckpointWriter&) = delete;
+
+    // Kopiuje stan i nowa czesc powtorki; zapis i fsync robi watek w tle.
+    void save(const SessionState& session, const Simulation& simulation, const Replay& replay);
+    // Usuwa zapis i dziennik (koniec gry); zalegly zapis nie odtworzy juz pliku.
+    void discard();
+    // Dziennik na dysku zawiera juz wczytana powtorke; kolejne zapisy tylko dopisuja.
+    void resumed(const Replay& replay);
+
+    const std::filesystem::path& path() const;
+
+private:
+    // Jedno zlecenie dla watku w tle; kolejne zapisy lacza sie z oczekujacym.
+    struct Job
+    {
+        bool remove{false};
+        // Nowa gra: dziennik zaczyna sie od naglowka powtorki.
+        bool restartJournal{false};
+        std::vector<std::byte> journal;
+        std::vector<std::byte> checkpoint;
+    };
+
+    void queue(Job job);
+    void writerLoop(std::stop_token stopToken);
+    void write(const Job& job);
+
+    std::filesystem::path path_;
+    std::filesystem::path journalPath_;
+
+    // Czesc powtorki juz przekazana do dziennika (watek gry).
+    std::optional<std::uint32_t> journalSeed_;
+    std::size_t journalDirections_{0};
+    std::size_t journalKeyframes_{0};
+    // Ustawiane przez watek w tle po bledzie zapisu; nastepny zapis pisze dziennik od nowa.
+    std::atomic<bool> failed_{false};
+
+    std::mutex mutex_;
+    std::condition_variable_any ready_;
+    std::optional<Job> pending_;
+    std::jthread writer_;
+};
+
+// Wczytuje zapis i dziennik powtorki i odtwarza stan symulacji; rzuca wyjatek gdy pliki sa
+// uszkodzone albo zostaly zapisane dla innej planszy. Dziennik jest przycinany do zapisu.
+LoadedCheckpoint loadCheckpoint(const std::filesystem::path& path, Simulation& simulation, const std::string& map);
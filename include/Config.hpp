@@ -1,6 +1,10 @@
 #pragma once
 
 #include <filesystem>
+#include <string_view>
+
+// Font w katalogu data, wspolny dla wszystkich okien i eksportu klatek.
+inline constexpr std::string_view fontFile = "JetBrainsMono-Regular.ttf";
 
 // Konfiguracja wczytywana z data/config.txt.
 struct Config
@@ -9,6 +13,11 @@ struct Config
     int height{};
     int tileSize{};
     int tickMs{};
+    // Liczba jedzenia i bonusow na planszy naraz (opcjonalne klucze food_count, power_ups).
+    int foodCount{1};
+    int powerUps{0};
+    // Opcjonalna mapa poziomu (sciezka wzgledem katalogu data); wyznacza rozmiar planszy.
+    std::filesystem::path map;
 };
 
 // Zwraca domyslne wartosci, gdy pliku brak, i waliduje gdy istnieje.
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "Config.hpp"
+#include "EndlessSimulation.hpp"
+
+#include <SFML/Graphics.hpp>
+#include <filesystem>
+#include <memory>
+
+// Okno trybu bez granic: kamera podaza za glowa weza.
+class EndlessGame
+{
+public:
+    EndlessGame(const Config& config, const std::filesystem::path& dataDir);
+
+    void run();
+
+private:
+    enum class State
+    {
+        Running,
+        Paused,
+        GameOver
+    };
+
+    void handleEvents();
+    void update(float dt);
+    void render();
+    void restart();
+    void updateTexts();
+    // Dodaje kafel (dwa trojkaty) do wspolnej tablicy wierzcholkow.
+    void appendTile(const GridPos& pos, const sf::Color& color);
+
+    Config config_;
+    std::unique_ptr<EndlessSimulation> simulation_;
+
+    sf::RenderWindow window_;
+    sf::Font font_;
+    sf::Text scoreText_;
+    sf::Text statusText_;
+    sf::VertexArray tiles_{sf::PrimitiveType::Triangles};
+
+    float accumulator_{0.F};
+    float tickSeconds_{0.F};
+    State state_{State::Running};
+    Direction pendingDirection_{Direction::Right};
+};
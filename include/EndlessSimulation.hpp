@@ -0,0 +1,28 @@
+#pragma once
+
+#include "Simulation.hpp"
+#include "World.hpp"
+
+#include <cstdint>
+#include <deque>
+
+// Logika trybu bez granic: waz porusza sie po nieskonczonym swiecie fragmentow.
+class EndlessSimulation
+{
+public:
+    explicit EndlessSimulation(std::uint32_t seed);
+
+    StepResult step(Direction direction);
+
+    const World& world() const;
+    const std::deque<GridPos>& body() const;
+    GridPos head() const;
+    Direction direction() const;
+    int score() const;
+
+private:
+    World world_;
+    std::deque<GridPos> body_;
+    Direction direction_{Direction::Right};
+    int score_{0};
+};
@@ -4,14 +4,104 @@
 #include "Random.hpp"
 #include "Snake.hpp"
 
-// Przechowuje pozycje jedzenia i odswieza ja po zjedzeniu
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+class ByteReader;
+
+// Rodzaj przedmiotu na planszy.
+enum class ItemKind : std::uint8_t
+{
+    Food,
+    // Bonusy: szybszy tik, skrocenie weza, przechodzenie przez wlasne cialo.
+    Speed,
+    Shrink,
+    Ghost
+};
+
+// Liczba przedmiotow na planszy (config: food_count, power_ups).
+struct ItemOptions
+{
+    int foodCount{1};
+    // Bonusy pojawiaja sie na czas i po zjedzeniu lub wygasnieciu wracaja po przerwie.
+    int powerUps{0};
+};
+
+struct Item
+{
+    Cell cell{};
+    ItemKind kind{ItemKind::Food};
+    bool active{false};
+    // Tik wygasniecia (aktywny bonus) albo ponownego pojawienia sie (nieaktywny).
+    std::uint64_t due{};
+};
+
+// Jedzenie i bonusy: stala pula przedmiotow, siatka numerow przedmiotow na polach
+// (odczyt pod glowa w O(1)) i kolo czasu dla bonusow, wiec koszt tiku nie rosnie z ich liczba.
 class Food
 {
 public:
-    const GridPos& position() const;
-    // Losuje nowe polozenie na wolnym polu
-    void respawn(const Board& board, const Snake& snake, Random& random);
+    Food(const Board& board, const ItemOptions& options);
+
+    // Pierwsze jedzenie (protokol bota; przy pelnej planszy ostatnie polozenie).
+    Cell position() const;
+    // Przedmiot na polu albo nullptr.
+    const Item* at(Cell cell) const
+    {
+        const std::int32_t slot = slotAt_[cell];
+        return slot < 0 ? nullptr : &items_[static_cast<std::size_t>(slot)];
+    }
+    // Czy wejscie na pole wydluza weza.
+    bool hasFood(Cell cell) const
+    {
+        const Item* item = at(cell);
+        return item != nullptr && item->kind == ItemKind::Food;
+    }
+    // Wszystkie sloty, takze nieaktywne bonusy (rysowanie pomija nieaktywne).
+    std::span<const Item> items() const;
+    const ItemOptions& options() const;
+
+    // Rozklada przedmioty od nowa na poczatku gry.
+    void reset(const Board& board, const Snake& snake, Random& random);
+    // Zdejmuje przedmiot z pola; jedzenie od razu wraca w nowym miejscu, bonus po przerwie.
+    void take(Cell cell, const Board& board, const Snake& snake, Random& random, std::uint64_t tick);
+    // Wygasza i wystawia bonusy zaplanowane na ten tik.
+    void advance(const Board& board, const Snake& snake, Random& random, std::uint64_t tick);
+
+    // Stan wszystkich slotow (zapis stanu gry).
+    void writeState(std::vector<std::byte>& output) const;
+    static std::vector<Item> readState(ByteReader& input);
+    // Odtwarza sloty z zapisu; rzuca wyjatek przed zmiana stanu, gdy sloty nie pasuja
+    // do ustawien, planszy lub ciala weza (posortowanego).
+    void restore(std::span<const Item> items, const Board& board, std::span<const Cell> sortedBody, std::uint64_t tick);
+    // Ustawia jedyne jedzenie (zapis stanu gry z jednym przedmiotem).
+    void place(Cell cell);
 
 private:
-    GridPos position_{};
+    static constexpr std::size_t wheelSize = 256;
+    static constexpr std::int32_t none = -1;
+
+    void put(std::size_t slot, Cell cell);
+    void remove(std::size_t slot);
+    // Losowe wolne pole (bez sciany, weza i przedmiotu); false gdy plansza pelna.
+    bool randomFreeCell(const Board& board, const Snake& snake, Random& random, Cell& result) const;
+    void schedule(std::size_t slot, std::uint64_t due);
+    void unschedule(std::size_t slot);
+
+    ItemOptions options_;
+    std::vector<Item> items_;
+    std::size_t activeItems_{0};
+    // Numer slotu na kazdym polu planszy albo none.
+    std::vector<std::int32_t> slotAt_;
+
+    // Kolo czasu: lista dwukierunkowa slotow w kazdym kubelku, bez alokacji w tiku.
+    std::array<std::int32_t, wheelSize> wheel_{};
+    std::vector<std::int32_t> timerNext_;
+    std::vector<std::int32_t> timerPrev_;
+    std::vector<std::uint8_t> scheduled_;
+    // Sloty na biezacy tik; pojemnosc z konstruktora, wiec tik nie alokuje.
+    std::vector<std::size_t> due_;
 };
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "Config.hpp"
+#include "Replay.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <limits>
+
+// Ustawienia eksportu klatek powtorki.
+struct ExportOptions
+{
+    std::filesystem::path outputDir;
+    // Surowe piksele RGBA zamiast PNG.
+    bool raw{false};
+    // 0 oznacza liczbe rdzeni.
+    unsigned int workers{0};
+    // Ile klatek moze czekac na zakodowanie.
+    std::size_t queueLimit{64};
+    // Zakres tikow do eksportu (fragment powtorki).
+    std::uint64_t firstTick{0};
+    std::uint64_t lastTick{std::numeric_limits<std::uint64_t>::max()};
+};
+
+struct ExportStats
+{
+    std::size_t frames{};
+    double seconds{};
+};
+
+// Renderuje powtorke poza ekranem i zapisuje klatki na dysk.
+// Kodowanie dziala na puli watkow, render nie czeka na zapis.
+ExportStats exportReplay(const Replay& replay,
+                         const Config& config,
+                         const std::filesystem::path& dataDir,
+                         const ExportOptions& options);
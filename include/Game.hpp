@@ -1,21 +1,28 @@
 #pragma once
 
-#include "Board.hpp"
+#include "BoardRenderer.hpp"
+#include "BotLink.hpp"
+#include "Checkpoint.hpp"
 #include "Config.hpp"
-#include "Food.hpp"
-#include "Random.hpp"
-#include "Snake.hpp"
+#include "ReplayRecorder.hpp"
+#include "Simulation.hpp"
 
 #include <SFML/Graphics.hpp>
 #include <filesystem>
+#include <optional>
+#include <span>
 #include <string>
+#include <utility>
 #include <vector>
 
 // Spina logike gry z wejscem, tickiem i renderem SFML.
 class Game
 {
 public:
-    Game(const Config& config, const std::filesystem::path& dataDir);
+    // Z opcjami bota kierunek podaje zewnetrzny proces zamiast klawiatury.
+    Game(const Config& config,
+         const std::filesystem::path& dataDir,
+         const std::optional<BotOptions>& bot = std::nullopt);
 
     void run();
 
@@ -36,14 +43,27 @@ private:
         GameOver
     };
 
+    // Poza rozgrywka petla czeka na zdarzenia zamiast rysowac kazda klatke.
+    bool isIdle() const;
     void handleEvents();
+    void waitForEvent();
+    void handleEvent(const sf::Event& event);
     void update(float dt);
     // Jedna aktualizacja logiki w tiku.
     void processTick();
+    // Czas tiku; bonus szybkosci skraca go o polowe.
+    float tickInterval() const;
     void render();
+    // Widok planszy; gdy nie miesci sie w oknie, przewija sie za glowa weza.
+    sf::View boardView() const;
 
     void reset();
-    void spawnFood();
+    // Przejscie do ekranu konca gry i zapis powtorki.
+    void endGame();
+    void saveLastReplay();
+    // Binarny zapis stanu do wznowienia po przerwie (autozapis, pauza, zamkniecie); pliki pisze watek w tle.
+    void writeCheckpoint();
+    void resumeCheckpoint();
 
     void loadHighscores();
     void saveHighscores();
@@ -59,10 +79,10 @@ private:
 
     Config config_;
     std::filesystem::path dataDir_;
-    Board board_;
-    Snake snake_;
-    Food food_;
-    Random random_;
+    Simulation simulation_;
+    ReplayRecorder recorder_;
+    CheckpointWriter checkpoints_;
+    std::optional<BotLink> bot_;
 
     sf::RenderWindow window_;
     sf::Font font_;
@@ -74,16 +94,32 @@ private:
     sf::Text instructionText_;
     sf::Text scoreboardText_;
 
-    sf::RectangleShape snakeShape_;
-    sf::RectangleShape foodShape_;
+    BoardRenderer boardRenderer_;
+    SpaceAnalyzer spaceAnalyzer_;
+    // Nakladka zagrozen pod klawiszem H.
+    bool showDanger_{false};
+    // Wynik analizy dla biezacego stanu; kazda zmiana symulacji ustawia dangerStale_.
+    bool dangerStale_{true};
+    const SpaceReport* dangerReport_{nullptr};
+    std::span<const Cell> dangerChokePoints_;
 
+    sf::Clock autosaveClock_;
     float accumulator_{0.F};
     float tickSeconds_{0.F};
-    int score_{0};
+    // Liczby pokazane w napisie wyniku (-1 wymusza pierwsze ustawienie).
+    int shownScore_{-1};
+    int shownBest_{-1};
+    std::size_t shownSpeedLevel_{0};
+    // Aktywne bonusy na napisie wyniku (szybkosc, duch).
+    std::pair<bool, bool> shownEffects_{false, false};
+    // Indeks w tabeli mnoznikow predkosci (0 = czas rzeczywisty).
+    std::size_t speedLevel_{0};
     std::vector<HighscoreEntry> highscores_;
     std::string playerName_;
     std::string nameInput_;
     bool highscoreRecorded_{false};
+    // Ustawiane przez updateTexts() i zdarzenia okna; render() je zeruje.
+    bool redraw_{true};
     State state_{State::EnterName};
     Direction pendingDirection_{Direction::Right};
 };
@@ -0,0 +1,11 @@
+#pragma once
+
+#include "Types.hpp"
+
+#include <SFML/Graphics.hpp>
+
+// Mapowanie klawiszy na kierunek.
+Direction directionFromKey(sf::Keyboard::Key key);
+
+// Ustawia srodek tekstu w zadanym punkcie.
+void centerText(sf::Text& text, const sf::Vector2f& center);
@@ -0,0 +1,16 @@
+#pragma once
+
+#include "Board.hpp"
+#include "Config.hpp"
+
+#include <filesystem>
+
+// Najwieksza obslugiwana plansza z pliku mapy.
+constexpr int maxMapSize = 4096;
+
+// Wczytuje mape poziomu: jeden wiersz tekstu na wiersz planszy,
+// '#' to sciana, '.' lub spacja to wolne pole.
+Board loadLevelMap(const std::filesystem::path& path);
+
+// Plansza z konfiguracji: z mapy gdy podana, inaczej pusta width x height.
+Board makeBoard(const Config& config, const std::filesystem::path& dataDir);
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <string_view>
+#include <vector>
+
+// Plik tylko do odczytu zmapowany w pamieci (mmap), bez kopiowania do bufora.
+// Na systemach bez mmap zawartosc jest wczytywana zwyczajnie.
+class MappedFile
+{
+public:
+    explicit MappedFile(const std::filesystem::path& path);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    std::string_view data() const;
+
+private:
+    const char* data_{nullptr};
+    std::size_t size_{0};
+    std::vector<char> fallback_;
+};
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "Board.hpp"
+#include "Policy.hpp"
+#include "QuantileSketch.hpp"
+#include "Simulation.hpp"
+
+#include <array>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+// Przyczyna konca gry bez okna.
+enum class DeathCause
+{
+    Wall,
+    Self,
+    // Gra przerwana po limicie tikow (strategia krecaca sie w kolko).
+    Timeout
+};
+
+// Wynik jednej gry strategii.
+struct GameOutcome
+{
+    int score{};
+    std::uint64_t ticks{};
+    DeathCause cause{};
+};
+
+// Rozgrywa gre od ziarna seed; to samo ziarno daje te sama gre dla kazdej strategii.
+// Opcjonalnie zbiera liczbe tikow miedzy kolejnymi jedzeniami.
+GameOutcome playPolicyGame(Simulation& simulation,
+                           Policy policy,
+                           PolicyState& state,
+                           std::uint32_t seed,
+                           std::uint64_t maxTicks,
+                           QuantileSketch* ticksPerFood = nullptr);
+
+// Limit tikow na gre: podany albo 100 tikow na wolne pole planszy.
+std::uint64_t resolveMaxTicks(const Board& board, std::uint64_t requested);
+
+// Ustawienia masowej symulacji gier bez okna.
+struct MassOptions
+{
+    std::uint64_t games{1000};
+    // 0 oznacza liczbe rdzeni.
+    unsigned int threads{0};
+    Policy policy{Policy::Greedy};
+    // Gra i dostaje ziarno seed + i niezaleznie od liczby watkow.
+    std::uint32_t seed{1};
+    // Limit tikow na gre; 0 oznacza 100 tikow na pole planszy.
+    std::uint64_t maxTicks{0};
+    // Jedzenie i bonusy jak w konfiguracji gry.
+    ItemOptions items;
+};
+
+// Statystyki gier jednego watku; watki licza osobno i lacza wyniki na koncu.
+struct GameStats
+{
+    void recordGame(int score, std::uint64_t ticks, DeathCause cause);
+    void merge(const GameStats& other);
+
+    std::uint64_t games{0};
+    std::array<std::uint64_t, 3> deaths{};
+    // Dokladny histogram wynikow (indeks = wynik).
+    std::vector<std::uint64_t> scoreHistogram;
+    QuantileSketch scores;
+    QuantileSketch lengths;
+    QuantileSketch ticksPerFood;
+};
+
+struct MassResult
+{
+    GameStats stats;
+    unsigned int threads{};
+    double seconds{};
+};
+
+// Rozgrywa gry na wielu watkach bez wspolnych blokad; postep idzie na stderr.
+MassResult runMassSimulation(const Board& board, const MassOptions& options);
+
+// Wyniki jako JSON (kwantyle, histogram wynikow, przyczyny smierci).
+void writeStatsJson(std::ostream& output, const MassResult& result, const MassOptions& options);
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+// Mierzone fazy petli gry.
+enum class PerfPhase
+{
+    Tick,
+    Respawn,
+    Render
+};
+
+// Opcjonalne liczniki sprzetowe (Linux perf_event_open) dla faz petli gry.
+// Wyniki sa sumowane w oknach po 1000 tikow i dopisywane do raportu.
+class PerfCounters
+{
+public:
+    static PerfCounters& instance();
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+    ~PerfCounters();
+
+    // Otwiera liczniki dla biezacego watku; rzuca wyjatek gdy niedostepne.
+    void enable(const std::filesystem::path& reportPath);
+    bool enabled() const;
+
+    void begin(PerfPhase phase);
+    void end(PerfPhase phase);
+    // Dopisuje niepelne okno na koniec pracy.
+    void flush();
+
+private:
+    static constexpr std::size_t phaseCount = 3;
+    static constexpr std::size_t counterCount = 4;
+    static constexpr std::uint64_t windowTicks = 1000;
+
+    using Reading = std::array<std::uint64_t, counterCount>;
+
+    // Sumy licznikow jednej fazy w oknie.
+    struct Totals
+    {
+        std::uint64_t calls{};
+        Reading counters{};
+    };
+
+    PerfCounters() = default;
+
+    bool read(Reading& reading) const;
+    void writeWindow();
+
+    std::array<int, counterCount> fds_{-1, -1, -1, -1};
+    std::thread::id owner_;
+    bool enabled_{false};
+    std::array<Reading, phaseCount> started_{};
+    std::array<Totals, phaseCount> window_{};
+    std::uint64_t ticks_{0};
+    std::uint64_t windowStart_{0};
+    std::ofstream report_;
+};
+
+// Mierzy faze od konstrukcji do konca zakresu; nic nie robi gdy profil wylaczony.
+class PerfScope
+{
+public:
+    explicit PerfScope(PerfPhase phase);
+    ~PerfScope();
+
+    PerfScope(const PerfScope&) = delete;
+    PerfScope& operator=(const PerfScope&) = delete;
+
+private:
+    PerfPhase phase_;
+    bool active_{false};
+};
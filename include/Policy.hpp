@@ -0,0 +1,32 @@
+#pragma once
+
+#include "Random.hpp"
+#include "Simulation.hpp"
+#include "SpaceAnalyzer.hpp"
+
+#include <string_view>
+
+// Wbudowane strategie sterowania do gier bez okna (masowe symulacje).
+enum class Policy
+{
+    // Losowy ruch sposrod bezpiecznych.
+    Random,
+    // Najkrotsza droga do najblizszego jedzenia sposrod bezpiecznych ruchow.
+    Greedy,
+    // Jak Greedy, ale omija ruchy zamykajace weza w zbyt malym obszarze.
+    Space
+};
+
+// Stan strategii jednej gry trzymany miedzy tikami.
+struct PolicyState
+{
+    Random random;
+    SpaceAnalyzer space;
+};
+
+// Rzuca wyjatek dla nieznanej nazwy.
+Policy policyFromName(std::string_view name);
+std::string_view policyName(Policy policy);
+
+// Kierunek na nastepny tik; bez bezpiecznego ruchu zostaje obecny kierunek.
+Direction choosePolicyMove(Policy policy, const Simulation& simulation, PolicyState& state);
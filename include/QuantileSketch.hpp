@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// Strumieniowy szkic kwantyli dla wartosci nieujemnych (logarytmiczne przedzialy,
+// jak w DDSketch). Kwantyl ma blad wzgledny najwyzej relativeError, a dwa szkice
+// laczy sie dodajac liczniki przedzialow, wiec watki moga liczyc osobno.
+class QuantileSketch
+{
+public:
+    explicit QuantileSketch(double relativeError = 0.01);
+
+    void add(double value);
+    // Dolicza drugi szkic o tej samej dokladnosci.
+    void merge(const QuantileSketch& other);
+
+    // Przyblizona wartosc kwantyla q z [0, 1]; 0 dla pustego szkicu.
+    double quantile(double q) const;
+
+    std::uint64_t count() const;
+    double mean() const;
+    double min() const;
+    double max() const;
+
+private:
+    std::size_t bucketIndex(double value) const;
+    double bucketValue(std::size_t index) const;
+
+    double relativeError_;
+    double logGamma_;
+    // Wartosci ponizej 1 (w grze: zera) trafiaja do osobnego licznika.
+    std::uint64_t zeroCount_{0};
+    std::vector<std::uint64_t> buckets_;
+    std::uint64_t count_{0};
+    double sum_{0.0};
+    double min_{0.0};
+    double max_{0.0};
+};
@@ -1,16 +1,34 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <random>
+#include <vector>
+
+class ByteReader;
 
 // Prosty generator liczb losowych dla gry.
 class Random
 {
 public:
     Random();
+    // Generator z zadanym ziarnem (powtarzalne gry i powtorki).
+    explicit Random(std::uint32_t seed);
 
     // Losuje liczbe calkowita z zakresu [min, max].
     int uniformInt(int min, int max);
 
+    void reseed(std::uint32_t seed);
+    std::uint32_t seed() const;
+
+    // Pelny stan silnika (zapis klatek kluczowych i wznawianie gry).
+    void writeState(std::vector<std::byte>& output) const;
+    void readState(ByteReader& input);
+
+    // Nowe ziarno z zegara dla kolejnej gry.
+    static std::uint32_t makeSeed();
+
 private:
+    std::uint32_t seed_{};
     std::mt19937 engine_;
 };
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "Types.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+// Klatka kluczowa: pelny stan gry po danym tiku (Simulation::writeState).
+struct Keyframe
+{
+    std::uint64_t tick{};
+    // Polozenie i dlugosc stanu w Replay::keyframeData.
+    std::uint64_t offset{};
+    std::uint64_t size{};
+};
+
+// Zapis rozgrywki: ziarno, rozmiar planszy i kierunek w kazdym tiku.
+struct Replay
+{
+    std::uint32_t seed{};
+    int width{};
+    int height{};
+    // Mapa poziomu wzgledem katalogu data (pusta dla planszy bez scian).
+    std::string map;
+    // Liczba jedzenia i bonusow na planszy (Simulation z tymi samymi ItemOptions).
+    int foodCount{1};
+    int powerUps{0};
+    std::vector<Direction> directions;
+    // Indeks klatek kluczowych posortowany po tiku (do wyszukiwania binarnego).
+    std::vector<Keyframe> keyframes;
+    std::vector<std::byte> keyframeData;
+};
+
+void saveReplay(const Replay& replay, const std::filesystem::path& path);
+// Rzuca wyjatek przy blednym lub uszkodzonym pliku.
+Replay loadReplay(const std::filesystem::path& path);
+
+// Zapis i odczyt powtorki w srodku innego pliku (np. zapisu stanu gry).
+// sizeLimit ogranicza rozmiary blokow odczytanych z danych.
+void writeReplay(std::ostream& output, const Replay& replay);
+Replay readReplay(std::istream& input, std::uintmax_t sizeLimit);
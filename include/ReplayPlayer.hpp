@@ -0,0 +1,28 @@
+#pragma once
+
+#include "Replay.hpp"
+#include "Simulation.hpp"
+
+#include <cstdint>
+
+// Odtwarzanie powtorki z dostepem swobodnym: seek() wraca do najblizszej
+// wczesniejszej klatki kluczowej i dogrywa brakujace tiki.
+class ReplayPlayer
+{
+public:
+    ReplayPlayer(const Replay& replay, Board board);
+
+    // Ustawia stan po danym tiku (0 to stan startowy); tik jest przycinany do dlugosci powtorki.
+    void seek(std::uint64_t tick);
+    // Jeden tik do przodu; false na koncu powtorki lub po smierci weza.
+    bool stepForward();
+
+    const Simulation& simulation() const;
+    std::uint64_t tick() const;
+    std::uint64_t length() const;
+
+private:
+    const Replay& replay_;
+    Simulation simulation_;
+    bool finished_{false};
+};
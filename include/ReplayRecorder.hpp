@@ -0,0 +1,31 @@
+#pragma once
+
+#include "Replay.hpp"
+#include "Simulation.hpp"
+
+#include <cstdint>
+#include <string>
+
+// Nagrywa kierunki kolejnych tikow i co keyframeInterval tikow pelny stan gry.
+class ReplayRecorder
+{
+public:
+    static constexpr std::uint64_t keyframeInterval = 4096;
+
+    ReplayRecorder();
+
+    // Nowe nagranie dla gry swiezo zresetowanej symulacji.
+    void start(const Simulation& simulation, const std::string& map);
+    // Kontynuacja nagrania wczytanego z zapisu stanu gry.
+    void restore(Replay replay);
+    // Wywolywane po kroku symulacji wykonanym w podanym kierunku.
+    void record(Direction direction, const Simulation& simulation);
+    // Czy ostatni zapis alokowal pamiec (klatka kluczowa lub wzrost bufora kierunkow).
+    bool allocatedLastTick() const;
+
+    const Replay& replay() const;
+
+private:
+    Replay replay_;
+    bool allocatedLastTick_{false};
+};
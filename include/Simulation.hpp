@@ -0,0 +1,66 @@
+#pragma once
+
+#include "Board.hpp"
+#include "Food.hpp"
+#include "Random.hpp"
+#include "Snake.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <span>
+#include <vector>
+
+// Wynik pojedynczego kroku symulacji.
+enum class StepResult
+{
+    Moved,
+    Ate,
+    HitWall,
+    HitSelf
+};
+
+// Logika jednej rozgrywki bez okna i grafiki (gra, powtorki, eksport).
+class Simulation
+{
+public:
+    Simulation(int width, int height, std::uint32_t seed);
+    // Gra na gotowej planszy (np. z mapy poziomu ze scianami), opcjonalnie z wieloma przedmiotami.
+    Simulation(Board board, std::uint32_t seed, const ItemOptions& items = {});
+
+    // Nowa gra z podanym ziarnem losowania jedzenia.
+    void reset(std::uint32_t seed);
+    // Jeden tick logiki w zadanym kierunku.
+    StepResult step(Direction direction);
+
+    // Zapis pelnego stanu gry (waz, przedmioty, bonusy, generator, wynik, tik) do bufora.
+    void writeState(std::vector<std::byte>& output) const;
+    // Odtwarza stan z zapisu dla tej samej planszy; rzuca wyjatek przy blednych danych.
+    void readState(std::span<const std::byte> input);
+
+    const Board& board() const;
+    const Snake& snake() const;
+    const Food& food() const;
+
+    int score() const;
+    std::uint32_t seed() const;
+    std::uint64_t tick() const;
+    // Aktywne bonusy: szybszy tik (gra z oknem) i przechodzenie przez wlasne cialo.
+    bool speedBoost() const;
+    bool ghost() const;
+
+private:
+    void applyPowerUp(ItemKind kind);
+
+    // Arena gry: fragmenty deque ciala wracaja do puli zamiast na sterte.
+    std::pmr::unsynchronized_pool_resource arena_;
+    Board board_;
+    Snake snake_;
+    Food food_;
+    Random random_;
+    Cell start_{};
+    int score_{0};
+    std::uint64_t tick_{0};
+    std::uint32_t speedTicks_{0};
+    std::uint32_t ghostTicks_{0};
+};
@@ -1,42 +1,63 @@
 #pragma once
 
+#include "Board.hpp"
 #include "Types.hpp"
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <deque>
-
-// Kierunek ruchu weza.
-enum class Direction
-{
-    Up,
-    Down,
-    Left,
-    Right
-};
+#include <memory_resource>
+#include <span>
+#include <vector>
 
 // Logika weza niezalezna od grafiki.
 class Snake
 {
 public:
-    Snake(const GridPos& start, int initialLength, Direction direction);
+    // Pamiec ciala pochodzi z areny gry (domyslnie zwykla sterta).
+    Snake(const Board& board,
+          Cell start,
+          int initialLength,
+          Direction direction,
+          std::pmr::memory_resource* memory = std::pmr::get_default_resource());
 
-    void reset(const GridPos& start, int initialLength, Direction direction);
+    void reset(Cell start, int initialLength, Direction direction);
+    // Odtwarza cialo z zapisu stanu (od glowy do ogona).
+    void restore(std::span<const Cell> body, Direction direction);
 
-    const std::deque<GridPos>& body() const;
-    GridPos head() const;
+    // Segmenty od glowy do ogona jako indeksy pol planszy.
+    const std::pmr::deque<Cell>& body() const;
+    Cell head() const;
 
     Direction direction() const;
     void setDirection(Direction direction);
 
-    GridPos nextHeadPosition() const;
+    Cell nextHeadPosition() const;
     // Przesuwa weza, opcjonalnie wydluzajac cialo.
     void move(bool grow);
+    // Odcina segmenty od ogona, zostawiajac co najmniej minLength.
+    void shrink(std::size_t segments, std::size_t minLength);
 
     // Sprawdza czy waz zajmuje dane pole.
-    bool occupies(const GridPos& pos) const;
+    bool occupies(Cell cell) const
+    {
+        return occupancy_[cell] != 0;
+    }
     // Sprawdza zderzenie glowy z cialem.
     bool selfCollision() const;
+    // Liczba roznych pol pod cialem (mniej niz segmentow, gdy bonus ducha nalozyl cialo na siebie).
+    std::size_t occupiedCells() const;
 
 private:
-    std::deque<GridPos> body_;
+    void occupy(Cell cell);
+    void release(Cell cell);
+
+    std::pmr::deque<Cell> body_;
+    // Liczba segmentow na kazdym polu: wiecej niz 1 po zderzeniu glowy albo po przejsciu ducha
+    // przez cialo. Nalozonych segmentow moze byc tyle, ile ma cialo, wiec licznik ma 32 bity.
+    std::pmr::vector<std::uint32_t> occupancy_;
+    std::size_t occupiedCells_{0};
+    std::array<std::int32_t, 4> steps_{};
     Direction direction_{Direction::Right};
 };
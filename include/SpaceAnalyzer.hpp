@@ -0,0 +1,85 @@
+#pragma once
+
+#include "Simulation.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// Ocena jednego ruchu glowy.
+struct MoveSpace
+{
+    Direction direction{};
+    // Ruch nie konczy gry w tym tiku.
+    bool safe{false};
+    // Liczba wolnych pol osiagalnych po ruchu (razem z polem docelowym). Liczenie konczy sie
+    // po przekroczeniu dlugosci weza albo po dojsciu do ogona, bo wiecej nie zmienia oceny.
+    std::uint32_t regionSize{0};
+    // Czy z pola docelowego da sie dojsc do ogona (waz nie zamyka sie w pulapce).
+    bool tailReachable{false};
+};
+
+// Wynik analizy dla trzech ruchow bez zawracania.
+struct SpaceReport
+{
+    std::array<MoveSpace, 3> moves{};
+    std::size_t moveCount{0};
+};
+
+// Analiza wolnej przestrzeni wokol glowy dla botow i podpowiedzi na ekranie.
+// Pole jest wolne, gdy da sie na nie wejsc i nie zajmuje go cialo; ogon liczymy jako wolny,
+// bo zwalnia sie w kolejnym tiku. Bufory zyja miedzy wywolaniami, a znaczniki epok
+// zastepuja czyszczenie tablic, wiec po pierwszym tiku analiza nie alokuje pamieci.
+// Koszt analyze() zalezy od dlugosci weza, a nie od rozmiaru planszy.
+class SpaceAnalyzer
+{
+public:
+    // Jedno wypelnianie na obszar sasiadujacy z glowa, wspolne dla wszystkich ruchow.
+    const SpaceReport& analyze(const Simulation& simulation);
+
+    // Punkty przeciecia (pola, ktorych zajecie dzieli obszar) w obszarach wokol glowy.
+    // Przechodzi cale obszary, wiec sluzy tylko podpowiedzi na ekranie.
+    std::span<const Cell> chokePoints(const Simulation& simulation);
+
+private:
+    // Ocena obszaru za ruchem (rozmiar do limitu i osiagalnosc ogona).
+    struct Region
+    {
+        std::uint32_t size{0};
+        bool tailReachable{false};
+    };
+
+    bool isFree(const Simulation& simulation, Cell cell) const;
+    // Przygotowuje bufory dla planszy i zaczyna nowa epoke znacznikow.
+    void beginPass(const Board& board);
+    // Wypelnia obszar do limitu pol albo do ogona; pole z przerwanego wypelniania
+    // obszaru earlier oznacza ten sam obszar, wiec zwraca jego ocene.
+    Region fillRegion(const Simulation& simulation,
+                      Cell start,
+                      std::uint32_t label,
+                      std::uint32_t limit,
+                      std::span<const Region> earlier);
+
+    SpaceReport report_;
+    std::uint32_t stamp_{0};
+    // Pole nalezy do obszaru label_ tylko gdy seen_ ma biezaca epoke.
+    std::vector<std::uint32_t> seen_;
+    std::vector<std::uint32_t> label_;
+    std::vector<Cell> queue_;
+
+    // Bufory algorytmu Tarjana, tworzone dopiero przy pierwszym pytaniu o punkty przeciecia.
+    struct DfsFrame
+    {
+        Cell cell;
+        std::uint32_t nextDirection;
+    };
+    std::vector<std::uint32_t> order_;
+    std::vector<std::uint32_t> low_;
+    std::vector<Cell> parent_;
+    // Epoka, w ktorej pole trafilo juz na liste punktow przeciecia.
+    std::vector<std::uint32_t> cut_;
+    std::vector<DfsFrame> stack_;
+    std::vector<Cell> chokePoints_;
+};
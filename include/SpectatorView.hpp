@@ -0,0 +1,90 @@
+#pragma once
+
+#include "Config.hpp"
+#include "Policy.hpp"
+#include "Simulation.hpp"
+
+#include <SFML/Graphics.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Okno widza: wiele gier bez okna ulozonych w siatce, kazda we wlasnym polu okna.
+// Tla plansz i sciany leza w statycznym buforze, a weze i jedzenie wszystkich gier
+// ida jedna tablica wierzcholkow, wiec klatka to dwa wywolania draw niezaleznie od liczby gier.
+// Gry i tablice wierzcholkow liczy osobny watek; petla okna tylko podmienia gotowa tablice i rysuje.
+class SpectatorView
+{
+public:
+    // maxTicks jak w MassOptions: 0 oznacza 100 tikow na wolne pole planszy.
+    SpectatorView(const Config& config,
+                  const std::filesystem::path& dataDir,
+                  int games,
+                  Policy policy,
+                  std::uint64_t maxTicks = 0);
+
+    void run();
+
+private:
+    // Polozenie i skala jednej planszy w oknie.
+    struct Viewport
+    {
+        sf::Vector2f origin;
+        float tile{};
+    };
+
+    void handleEvents();
+    // Watek gier: tiki w rytmie tickMs, po kazdym tiku nowa tablica wierzcholkow.
+    void stepLoop(std::stop_token stopToken);
+    // Jeden tik wszystkich gier; skonczone i przekroczone gry zaczynaja sie od nowa.
+    void stepGames();
+    void buildVertices(const std::vector<Viewport>& viewports);
+    void render();
+    // Dobiera siatke do rozmiaru okna i buduje statyczna warstwe plansz.
+    void layout(sf::Vector2u windowSize);
+    void updateTexts();
+
+    Config config_;
+    Policy policy_;
+    std::uint64_t maxTicks_{};
+    // Gry i stany strategii nalezy po starcie run() tylko do watku gier.
+    std::vector<std::unique_ptr<Simulation>> games_;
+    std::vector<PolicyState> policyStates_;
+    std::uint32_t nextSeed_{};
+    // Pisze tylko watek gier; okno odswieza status, gdy licznik sie zmieni.
+    std::atomic<std::uint64_t> finishedGames_{0};
+    std::atomic<std::uint64_t> timedOutGames_{0};
+    std::atomic<int> bestScore_{0};
+    std::uint64_t shownFinishedGames_{0};
+
+    sf::RenderWindow window_;
+    sf::Font font_;
+    sf::Text statusText_;
+
+    std::vector<sf::Vertex> staticVertices_;
+    sf::VertexBuffer staticBuffer_{sf::PrimitiveType::Triangles, sf::VertexBuffer::Usage::Static};
+    bool useStaticBuffer_{false};
+    // Tablica rysowana przez okno.
+    std::vector<sf::Vertex> dynamicVertices_;
+    // Tablica budowana przez watek gier.
+    std::vector<sf::Vertex> workVertices_;
+
+    float tickSeconds_{0.F};
+
+    // Chroni uklad siatki, gotowa tablice i pauze (pauze zmienia tylko okno).
+    std::mutex mutex_;
+    std::condition_variable_any wake_;
+    std::vector<Viewport> viewports_;
+    std::uint64_t layoutGeneration_{0};
+    std::vector<sf::Vertex> readyVertices_;
+    bool verticesReady_{false};
+    bool paused_{false};
+
+    // Ostatnie pole: zatrzymuje watek gier przed zniszczeniem gier i bufora.
+    std::jthread stepper_;
+};
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "Board.hpp"
+#include "Food.hpp"
+#include "Policy.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+// Ustawienia turnieju strategii na wspolnym zestawie gier.
+struct TournamentOptions
+{
+    std::vector<Policy> policies;
+    // Gra i ma ziarno seed + i dla kazdej strategii (porownanie w parach).
+    std::uint32_t seed{1};
+    std::uint64_t minGames{256};
+    std::uint64_t maxGames{100000};
+    // Turniej konczy sie, gdy kazda para strategii ma 95% przedzial ufnosci roznicy
+    // wynikow wezszy niz +-ciHalfWidth (albo po maxGames).
+    double ciHalfWidth{0.5};
+    // 0 oznacza liczbe rdzeni.
+    unsigned int threads{0};
+    // Limit tikow na gre; 0 oznacza 100 tikow na pole planszy.
+    std::uint64_t maxTicks{0};
+    // Jedzenie i bonusy jak w konfiguracji gry.
+    ItemOptions items;
+};
+
+// Sredni wynik z 95% przedzialem ufnosci (srednia +- halfWidth).
+struct ScoreEstimate
+{
+    double mean{};
+    double halfWidth{};
+};
+
+struct PairResult
+{
+    std::size_t first{};
+    std::size_t second{};
+    // Wynik first minus wynik second na tych samych grach.
+    ScoreEstimate difference;
+};
+
+struct TournamentResult
+{
+    // Gry uzyte w wynikach (pelne bloki do momentu zatrzymania, niezalezne od liczby watkow).
+    std::uint64_t games{};
+    bool stoppedEarly{false};
+    std::vector<ScoreEstimate> scores;
+    std::vector<PairResult> pairs;
+    // Wszystkie rozegrane gry i tiki (razem z odrzuconymi po zatrzymaniu) do przepustowosci.
+    std::uint64_t playedGames{};
+    std::uint64_t playedTicks{};
+    unsigned int threads{};
+    double seconds{};
+};
+
+// Rozgrywa gry strategii rownolegle i konczy, gdy wyniki przestaja sie zmieniac.
+TournamentResult runTournament(const Board& board, const TournamentOptions& options);
+
+void writeTournamentJson(std::ostream& output, const TournamentResult& result, const TournamentOptions& options);
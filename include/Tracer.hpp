@@ -0,0 +1,104 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Opcjonalna os czasu w formacie Chrome trace-event JSON (chrome://tracing, ui.perfetto.dev).
+// Kazdy watek zapisuje zdarzenia do wlasnego bufora bez blokad; pelne bufory
+// trafiaja do watku zapisujacego, wiec petla gry nie czeka na dysk.
+class Tracer
+{
+public:
+    static Tracer& instance();
+
+    Tracer(const Tracer&) = delete;
+    Tracer& operator=(const Tracer&) = delete;
+    ~Tracer();
+
+    // Otwiera plik i uruchamia watek zapisujacy.
+    void enable(const std::filesystem::path& path);
+    bool enabled() const
+    {
+        return enabled_.load(std::memory_order_relaxed);
+    }
+
+    // Nazwa musi byc literalem (zapisujemy tylko wskaznik).
+    void record(const char* name, std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end);
+    // Oddaje bufor biezacego watku, czeka na zapis i zamyka plik.
+    void flush();
+
+    // Bufor zdarzen jednego watku.
+    struct Event
+    {
+        const char* name;
+        std::int64_t startNs;
+        std::int64_t durationNs;
+    };
+    struct Batch
+    {
+        static constexpr std::size_t capacity = 4096;
+        std::uint32_t threadId{};
+        std::size_t count{0};
+        std::array<Event, capacity> events;
+    };
+
+    // Oddaje bufor konczacego sie watku (zdarzenia do zapisu, pusty do puli).
+    void detach(std::unique_ptr<Batch> batch);
+
+private:
+    Tracer() = default;
+
+    // Przekazuje pelny bufor do zapisu i zwraca pusty; przy limicie buforow
+    // zwraca ten sam bufor wyczyszczony, a zdarzenia przepadaja.
+    std::unique_ptr<Batch> submit(std::unique_ptr<Batch> batch);
+    // Daje biezacemu watkowi bufor (z puli, gdy jest) przy pierwszym uzyciu.
+    void attachThread();
+    // Nowy bufor, o ile nie przekroczy limitu; wolane pod mutex_.
+    bool reserveBatch();
+    // Zatrzymuje watek zapisujacy i zamyka plik; nie dotyka buforow watkow.
+    void finish();
+    void writerLoop(std::stop_token stopToken);
+    void writeBatch(const Batch& batch);
+
+    std::atomic<bool> enabled_{false};
+    std::atomic<std::uint32_t> nextThreadId_{1};
+    std::chrono::steady_clock::time_point epoch_;
+
+    std::mutex mutex_;
+    std::condition_variable_any ready_;
+    std::vector<std::unique_ptr<Batch>> pending_;
+    std::vector<std::unique_ptr<Batch>> spare_;
+    // Wszystkie bufory (w watkach, w kolejce i w puli) i zdarzenia pominiete przy limicie.
+    std::size_t batchCount_{0};
+    std::atomic<std::uint64_t> droppedEvents_{0};
+
+    std::ofstream output_;
+    bool firstEvent_{true};
+    std::jthread writer_;
+};
+
+// Mierzy zakres od konstrukcji do konca; nic nie robi, gdy os czasu wylaczona.
+class TraceScope
+{
+public:
+    explicit TraceScope(const char* name);
+    ~TraceScope();
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    const char* name_;
+    bool active_;
+    std::chrono::steady_clock::time_point start_;
+};
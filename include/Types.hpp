@@ -1,6 +1,7 @@
 #pragma once
 
 #include <compare>
+#include <cstdint>
 
 // Pozycja na siatce planszy.
 struct GridPos
@@ -15,3 +16,41 @@ inline GridPos operator+(const GridPos& lhs, const GridPos& rhs)
 {
     return {lhs.x + rhs.x, lhs.y + rhs.y};
 }
+
+// Kierunek ruchu weza.
+enum class Direction : std::uint8_t
+{
+    Up,
+    Down,
+    Left,
+    Right
+};
+
+// Czy kierunki sa przeciwne (zawrocenie w miejscu).
+inline bool areOpposite(Direction current, Direction next)
+{
+    return (current == Direction::Up && next == Direction::Down) ||
+           (current == Direction::Down && next == Direction::Up) ||
+           (current == Direction::Left && next == Direction::Right) ||
+           (current == Direction::Right && next == Direction::Left);
+}
+
+// Zamiana kierunku na przesuniecie na siatce.
+inline GridPos directionOffset(Direction direction)
+{
+    switch (direction)
+    {
+    case Direction::Up:
+        return {0, -1};
+    case Direction::Down:
+        return {0, 1};
+    case Direction::Left:
+        return {-1, 0};
+    case Direction::Right:
+    default:
+        return {1, 0};
+    }
+}
+
+// Liniowy indeks pola planszy razem z ramka (patrz Board::cell).
+using Cell = std::uint32_t;
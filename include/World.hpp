@@ -0,0 +1,126 @@
+#pragma once
+
+#include "Board.hpp"
+#include "Types.hpp"
+
+#include <bitset>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+// Bok fragmentu swiata w polach (potega dwojki dla szybkiego dzielenia).
+constexpr int chunkShift = 5;
+constexpr int chunkSize = 1 << chunkShift;
+
+// Wspolrzedne fragmentu swiata.
+struct ChunkKey
+{
+    int x{};
+    int y{};
+
+    auto operator<=>(const ChunkKey&) const = default;
+};
+
+struct ChunkKeyHash
+{
+    std::size_t operator()(const ChunkKey& key) const;
+};
+
+// Fragment nieskonczonego swiata: sciany na planszy chunkSize x chunkSize,
+// jedzenie i segmenty weza jako bity indeksowane y * chunkSize + x.
+struct Chunk
+{
+    static constexpr std::size_t cells = static_cast<std::size_t>(chunkSize * chunkSize);
+
+    Board terrain{chunkSize, chunkSize};
+    std::bitset<cells> food;
+    std::bitset<cells> snake;
+    int snakeSegments{0};
+};
+
+ChunkKey chunkKeyOf(const GridPos& pos);
+// Deterministyczne generowanie fragmentu z ziarna swiata.
+std::unique_ptr<Chunk> generateChunk(const ChunkKey& key, std::uint32_t worldSeed);
+
+// Generuje fragmenty na watkach w tle; tik tylko zamawia i odbiera gotowe.
+class ChunkStreamer
+{
+public:
+    ChunkStreamer(std::uint32_t worldSeed, unsigned int workers);
+    ~ChunkStreamer();
+
+    ChunkStreamer(const ChunkStreamer&) = delete;
+    ChunkStreamer& operator=(const ChunkStreamer&) = delete;
+
+    // Dopisuje zamowienia; false gdy kolejka jest zajeta (sprobujemy w nastepnym tiku).
+    bool tryRequest(const std::vector<ChunkKey>& keys);
+    // Przenosi gotowe fragmenty do wyniku, bez czekania na generowanie.
+    void takeReady(std::vector<std::pair<ChunkKey, std::unique_ptr<Chunk>>>& ready);
+    // Usuwa z kolejki zamowienia dalsze niz radius od center i dopisuje je do dropped;
+    // false gdy kolejka jest zajeta.
+    bool tryDropOutside(const ChunkKey& center, int radius, std::vector<ChunkKey>& dropped);
+
+private:
+    void workerLoop(std::stop_token stop);
+
+    std::uint32_t worldSeed_{};
+    std::mutex mutex_;
+    std::condition_variable_any hasWork_;
+    std::deque<ChunkKey> requests_;
+    std::vector<std::pair<ChunkKey, std::unique_ptr<Chunk>>> ready_;
+    std::vector<std::jthread> workers_;
+};
+
+// Nieskonczony swiat z rzadko przechowywanymi fragmentami wokol weza.
+class World
+{
+public:
+    explicit World(std::uint32_t seed);
+
+    // Co tik: zamawia fragmenty wokol i przed glowa, odbiera gotowe, usuwa dalekie.
+    void update(const GridPos& head, Direction heading);
+
+    bool blocked(const GridPos& pos);
+    // Zjada jedzenie z pola, jesli tam jest.
+    bool takeFood(const GridPos& pos);
+    bool snakeAt(const GridPos& pos);
+    void setSnake(const GridPos& pos, bool present);
+
+    // Fragment jesli jest w pamieci (do rysowania).
+    const Chunk* find(const ChunkKey& key) const;
+    std::size_t loadedChunks() const;
+    // Ile fragmentow tik potrzebowal zanim byly gotowe.
+    std::size_t missedChunks() const;
+
+private:
+    // Fragment pod polem; brakujacy staje sie od razu pustym terenem.
+    Chunk& chunkAt(const GridPos& pos);
+    // Dodaje wygenerowany fragment bez jedzenia zjedzonego tam wczesniej.
+    void insertChunk(const ChunkKey& key, std::unique_ptr<Chunk> chunk);
+    void requestAround(const ChunkKey& center, Direction heading);
+    void evictFar(const ChunkKey& center);
+
+    std::uint32_t seed_{};
+    std::unordered_map<ChunkKey, std::unique_ptr<Chunk>, ChunkKeyHash> chunks_;
+    std::unordered_set<ChunkKey, ChunkKeyHash> pending_;
+    std::vector<std::pair<ChunkKey, std::unique_ptr<Chunk>>> ready_;
+    std::vector<ChunkKey> wanted_;
+    std::vector<ChunkKey> dropped_;
+    // Zjedzone jedzenie fragmentow; przezywa usuniecie fragmentu, wiec ponowne wygenerowanie
+    // go z ziarna nie przywraca jedzenia.
+    std::unordered_map<ChunkKey, std::bitset<Chunk::cells>, ChunkKeyHash> eaten_;
+    ChunkKey lastCenter_{};
+    // Po zmianie fragmentu glowy zamowienia poza zasiegiem czekaja na usuniecie z kolejki.
+    bool dropStale_{false};
+    std::size_t missedChunks_{0};
+    ChunkStreamer streamer_;
+};
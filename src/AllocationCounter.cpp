@@ -0,0 +1,57 @@
+#include "AllocationCounter.hpp"
+
+#ifdef SNAKE_COUNT_ALLOCATIONS
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+thread_local std::uint64_t allocations = 0;
+} // namespace
+
+// Zastapione operatory new/delete; wyrownane wersje zostaja standardowe i nie sa liczone.
+void* operator new(std::size_t size)
+{
+    ++allocations;
+    if (void* pointer = std::malloc(size == 0 ? 1 : size))
+    {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    return ::operator new(size);
+}
+
+void operator delete(void* pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept
+{
+    std::free(pointer);
+}
+
+std::uint64_t threadAllocationCount()
+{
+    return allocations;
+}
+#else
+std::uint64_t threadAllocationCount()
+{
+    return 0;
+}
+#endif
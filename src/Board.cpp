@@ -1,8 +1,25 @@
 #include "Board.hpp"
 
 Board::Board(int width, int height)
-    : width_(width), height_(height)
+    : width_(width), height_(height), stride_(width + 2)
 {
+    // Kolejnosc jak w Direction: Up, Down, Left, Right.
+    steps_ = {-stride_, stride_, -1, 1};
+
+    // Blokujemy ramke wokol planszy.
+    blocked_.assign((cellCount() + 63) / 64, 0);
+    for (int x = -1; x <= width_; ++x)
+    {
+        block(cell({x, -1}));
+        block(cell({x, height_}));
+    }
+    for (int y = 0; y < height_; ++y)
+    {
+        block(cell({-1, y}));
+        block(cell({width_, y}));
+    }
+
+    passableCount_ = static_cast<std::size_t>(width_) * static_cast<std::size_t>(height_);
 }
 
 int Board::width() const
@@ -20,3 +37,49 @@ bool Board::inside(const GridPos& pos) const
     // Sprawdza czy pozycja jest wewnatrz planszy
     return pos.x >= 0 && pos.x < width_ && pos.y >= 0 && pos.y < height_;
 }
+
+void Board::setWall(const GridPos& pos)
+{
+    const Cell wall = cell(pos);
+    if (inside(pos) && passable(wall))
+    {
+        block(wall);
+        --passableCount_;
+    }
+}
+
+std::size_t Board::passableCount() const
+{
+    return passableCount_;
+}
+
+bool Board::hasWalls() const
+{
+    return passableCount_ < static_cast<std::size_t>(width_) * static_cast<std::size_t>(height_);
+}
+
+std::size_t Board::cellCount() const
+{
+    return static_cast<std::size_t>(stride_) * static_cast<std::size_t>(height_ + 2);
+}
+
+Cell Board::cell(const GridPos& pos) const
+{
+    return static_cast<Cell>((pos.y + 1) * stride_ + pos.x + 1);
+}
+
+GridPos Board::position(Cell cell) const
+{
+    const int index = static_cast<int>(cell);
+    return {index % stride_ - 1, index / stride_ - 1};
+}
+
+const std::array<std::int32_t, 4>& Board::steps() const
+{
+    return steps_;
+}
+
+void Board::block(Cell cell)
+{
+    blocked_[cell >> 6] |= std::uint64_t{1} << (cell & 63);
+}
@@ -0,0 +1,164 @@
+#include "BoardRenderer.hpp"
+
+#include <array>
+#include <stdexcept>
+
+namespace
+{
+const sf::Color deadlyColor(230, 40, 40, 150);
+const sf::Color trapColor(240, 150, 30, 130);
+const sf::Color chokeColor(240, 220, 60, 60);
+
+std::array<sf::Vertex, 6> quadVertices(sf::Vector2f topLeft, sf::Vector2f size, sf::Color color)
+{
+    const sf::Vertex a{topLeft, color, {}};
+    const sf::Vertex b{{topLeft.x + size.x, topLeft.y}, color, {}};
+    const sf::Vertex c{{topLeft.x, topLeft.y + size.y}, color, {}};
+    const sf::Vertex d{{topLeft.x + size.x, topLeft.y + size.y}, color, {}};
+    return {a, b, c, b, d, c};
+}
+
+// Kafel pola planszy.
+void appendTile(sf::VertexArray& tiles, const GridPos& pos, float tile, const sf::Color& color)
+{
+    appendQuad(tiles, {static_cast<float>(pos.x) * tile, static_cast<float>(pos.y) * tile}, {tile, tile}, color);
+}
+} // namespace
+
+void appendQuad(sf::VertexArray& vertices, sf::Vector2f topLeft, sf::Vector2f size, sf::Color color)
+{
+    for (const sf::Vertex& vertex : quadVertices(topLeft, size, color))
+    {
+        vertices.append(vertex);
+    }
+}
+
+void appendQuad(std::vector<sf::Vertex>& vertices, sf::Vector2f topLeft, sf::Vector2f size, sf::Color color)
+{
+    const std::array<sf::Vertex, 6> quad = quadVertices(topLeft, size, color);
+    vertices.insert(vertices.end(), quad.begin(), quad.end());
+}
+
+sf::Color itemColor(ItemKind kind)
+{
+    switch (kind)
+    {
+    case ItemKind::Speed:
+        return {80, 170, 240};
+    case ItemKind::Shrink:
+        return {190, 110, 230};
+    case ItemKind::Ghost:
+        return {230, 230, 230};
+    case ItemKind::Food:
+    default:
+        return {220, 80, 60};
+    }
+}
+
+BoardRenderer::BoardRenderer(int tileSize)
+    : tileSize_(tileSize)
+{
+    snakeShape_.setSize(sf::Vector2f(static_cast<float>(tileSize_), static_cast<float>(tileSize_)));
+    snakeShape_.setFillColor(sf::Color(30, 160, 60));
+}
+
+void BoardRenderer::draw(sf::RenderTarget& target, const Simulation& simulation)
+{
+    const Board& board = simulation.board();
+    if (board.hasWalls())
+    {
+        if (backgroundBoard_ != &board)
+        {
+            buildBackground(board);
+        }
+        target.draw(*backgroundSprite_);
+    }
+
+    for (const Cell cell : simulation.snake().body())
+    {
+        const GridPos segment = board.position(cell);
+        snakeShape_.setPosition(
+            {static_cast<float>(segment.x * tileSize_), static_cast<float>(segment.y * tileSize_)});
+        target.draw(snakeShape_);
+    }
+
+    itemTiles_.clear();
+    for (const Item& item : simulation.food().items())
+    {
+        if (item.active)
+        {
+            appendTile(itemTiles_, board.position(item.cell), static_cast<float>(tileSize_), itemColor(item.kind));
+        }
+    }
+    target.draw(itemTiles_);
+}
+
+void BoardRenderer::drawDanger(sf::RenderTarget& target,
+                               const Simulation& simulation,
+                               const SpaceReport& report,
+                               std::span<const Cell> chokePoints)
+{
+    const Board& board = simulation.board();
+    const auto tile = static_cast<float>(tileSize_);
+
+    dangerTiles_.clear();
+    for (const Cell cell : chokePoints)
+    {
+        appendTile(dangerTiles_, board.position(cell), tile, chokeColor);
+    }
+
+    // Pulapka: obszar za maly na weza i bez drogi do ogona.
+    const auto length = static_cast<std::uint32_t>(simulation.snake().body().size());
+    for (std::size_t i = 0; i < report.moveCount; ++i)
+    {
+        const MoveSpace& move = report.moves[i];
+        const Cell next = neighbor(simulation.snake().head(), board.step(move.direction));
+        if (!move.safe)
+        {
+            // Ramki planszy nie ma na ekranie.
+            if (board.inside(board.position(next)))
+            {
+                appendTile(dangerTiles_, board.position(next), tile, deadlyColor);
+            }
+        }
+        else if (!move.tailReachable && move.regionSize < length)
+        {
+            appendTile(dangerTiles_, board.position(next), tile, trapColor);
+        }
+    }
+
+    target.draw(dangerTiles_);
+}
+
+void BoardRenderer::buildBackground(const Board& board)
+{
+    // Jeden teksel na pole; sprite skalujemy do rozmiaru kafla,
+    // zeby tlo mapy 4096x4096 zmiescilo sie w limicie rozmiaru tekstury.
+    if (!background_.resize({static_cast<unsigned int>(board.width()), static_cast<unsigned int>(board.height())}))
+    {
+        throw std::runtime_error("Failed to create background texture");
+    }
+
+    sf::VertexArray walls(sf::PrimitiveType::Triangles);
+    const sf::Color wallColor(90, 90, 110);
+    for (int y = 0; y < board.height(); ++y)
+    {
+        for (int x = 0; x < board.width(); ++x)
+        {
+            if (board.passable(board.cell({x, y})))
+            {
+                continue;
+            }
+
+            appendTile(walls, {x, y}, 1.F, wallColor);
+        }
+    }
+
+    background_.clear(sf::Color::Transparent);
+    background_.draw(walls);
+    background_.display();
+
+    backgroundSprite_.emplace(background_.getTexture());
+    backgroundSprite_->setScale({static_cast<float>(tileSize_), static_cast<float>(tileSize_)});
+    backgroundBoard_ = &board;
+}
@@ -0,0 +1,366 @@
+#include "BotLink.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cerrno>
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <print>
+#include <stdexcept>
+#include <string>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <csignal>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#define SNAKE_HAS_BOT_LINK 1
+#endif
+
+namespace
+{
+// Zapas bufora wyjscia na zmiany z jednej wymiany (wiecej tylko dla duzych map ze scianami).
+constexpr std::size_t bytesPerTick = 32;
+constexpr std::size_t minOutputCapacity = 64 * 1024;
+
+#ifdef SNAKE_HAS_BOT_LINK
+// Czeka na jednego klienta pod sciezka gniazda.
+int acceptClient(const std::filesystem::path& path, int& listener)
+{
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    const std::string name = path.string();
+    if (name.size() >= sizeof(address.sun_path))
+    {
+        throw std::invalid_argument("Bot socket path is too long: " + name);
+    }
+    std::memcpy(address.sun_path, name.c_str(), name.size() + 1);
+
+    listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listener == -1)
+    {
+        throw std::runtime_error("Failed to create bot socket");
+    }
+
+    // Gniazdo po poprzednim uruchomieniu blokowaloby bind.
+    std::filesystem::remove(path);
+    if (bind(listener, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) == -1 ||
+        ::listen(listener, 1) == -1)
+    {
+        throw std::runtime_error("Failed to listen on bot socket: " + name);
+    }
+
+    std::println(stderr, "Waiting for bot on {}", name);
+    const int client = accept(listener, nullptr, nullptr);
+    if (client == -1)
+    {
+        throw std::runtime_error("Failed to accept bot connection: " + name);
+    }
+    return client;
+}
+#endif
+} // namespace
+
+BotLink::BotLink(const BotOptions& options)
+    : batch_(options.batch)
+{
+    if (batch_ < 1 || batch_ > BotOptions::maxBatch)
+    {
+        throw std::invalid_argument("Bot batch must be between 1 and " + std::to_string(BotOptions::maxBatch));
+    }
+
+#ifdef SNAKE_HAS_BOT_LINK
+    // Zamkniety bot ma konczyc gre bledem zapisu, a nie sygnalem.
+    std::signal(SIGPIPE, SIG_IGN);
+
+    if (options.socket.empty())
+    {
+        input_ = STDIN_FILENO;
+        output_ = STDOUT_FILENO;
+    }
+    else
+    {
+        socketPath_ = options.socket;
+        input_ = acceptClient(socketPath_, listener_);
+        output_ = input_;
+    }
+#else
+    throw std::runtime_error("Bot protocol is not supported on this platform");
+#endif
+
+    outBuffer_.reserve(std::max(minOutputCapacity, static_cast<std::size_t>(batch_) * bytesPerTick));
+}
+
+BotLink::~BotLink()
+{
+#ifdef SNAKE_HAS_BOT_LINK
+    if (listener_ != -1)
+    {
+        close(input_);
+        close(listener_);
+        std::error_code ignored;
+        std::filesystem::remove(socketPath_, ignored);
+    }
+#endif
+}
+
+void BotLink::startGame(const Simulation& simulation)
+{
+    const Board& board = simulation.board();
+
+    append("game ");
+    appendNumber(board.width());
+    append(" ");
+    appendNumber(board.height());
+    append(" ");
+    appendNumber(batch_);
+    append("\n");
+
+    if (board.hasWalls())
+    {
+        append("walls ");
+        appendNumber(static_cast<std::int64_t>(static_cast<std::size_t>(board.width()) * board.height() -
+                                               board.passableCount()));
+        for (int y = 0; y < board.height(); ++y)
+        {
+            for (int x = 0; x < board.width(); ++x)
+            {
+                const Cell cell = board.cell({x, y});
+                if (!board.passable(cell))
+                {
+                    appendPosition(board, cell);
+                }
+            }
+        }
+        append("\n");
+    }
+
+    append("snake ");
+    appendNumber(static_cast<std::int64_t>(simulation.snake().body().size()));
+    for (const Cell segment : simulation.snake().body())
+    {
+        appendPosition(board, segment);
+    }
+    append("\nfood");
+    appendPosition(board, simulation.food().position());
+    append("\n");
+
+    // Ruchy zaplanowane dla poprzedniej gry przepadaja.
+    moveCount_ = 0;
+    nextMove_ = 0;
+}
+
+std::optional<Direction> BotLink::nextMove(Direction current)
+{
+    if (nextMove_ == moveCount_)
+    {
+        append("go\n");
+        const auto sent = std::chrono::steady_clock::now();
+        flush();
+
+        std::string_view line;
+        if (!readLine(line) || line == "quit")
+        {
+            return std::nullopt;
+        }
+        recordLatency(static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - sent).count()));
+
+        if (line.size() > static_cast<std::size_t>(batch_))
+        {
+            throw std::runtime_error("Bot sent more moves than the batch size");
+        }
+        // Pusta linia to jeden tik bez zmiany kierunku.
+        if (line.empty())
+        {
+            line = ".";
+        }
+        std::copy(line.begin(), line.end(), moves_.begin());
+        moveCount_ = line.size();
+        nextMove_ = 0;
+    }
+
+    ++ticks_;
+    switch (moves_[nextMove_++])
+    {
+    case 'U':
+        return Direction::Up;
+    case 'D':
+        return Direction::Down;
+    case 'L':
+        return Direction::Left;
+    case 'R':
+        return Direction::Right;
+    case '.':
+        return current;
+    default:
+        throw std::runtime_error("Invalid bot move: " + std::string(1, moves_[nextMove_ - 1]));
+    }
+}
+
+void BotLink::recordTick(const Simulation& simulation, StepResult result)
+{
+    const Board& board = simulation.board();
+
+    switch (result)
+    {
+    case StepResult::Moved:
+        append("m");
+        appendPosition(board, simulation.snake().head());
+        append("\n");
+        break;
+    case StepResult::Ate:
+        append("e");
+        appendPosition(board, simulation.snake().head());
+        appendPosition(board, simulation.food().position());
+        append("\n");
+        break;
+    case StepResult::HitWall:
+    case StepResult::HitSelf:
+        append("over ");
+        appendNumber(simulation.score());
+        append(result == StepResult::HitWall ? " wall\n" : " self\n");
+        // Koniec gry bot dostaje od razu, nawet jesli okno zaraz sie zamknie.
+        flush();
+        break;
+    }
+}
+
+void BotLink::report() const
+{
+    if (rounds_ == 0)
+    {
+        return;
+    }
+
+    // Gorne granice przedzialow histogramu dla percentyli.
+    const auto percentile = [this](double fraction)
+    {
+        const auto target = static_cast<std::uint64_t>(fraction * static_cast<double>(rounds_));
+        std::uint64_t seen = 0;
+        for (std::size_t bucket = 0; bucket < latencyBuckets_.size(); ++bucket)
+        {
+            seen += latencyBuckets_[bucket];
+            if (seen > target)
+            {
+                return std::uint64_t{1} << bucket;
+            }
+        }
+        return latencyMax_;
+    };
+
+    const double mean = static_cast<double>(latencySum_) / static_cast<double>(rounds_);
+    std::println(stderr,
+                 "Bot: {} rounds, {} ticks, round trip mean {:.1f} us, p50 < {} us, p99 < {} us, max {} us, "
+                 "{:.2f} us per tick",
+                 rounds_,
+                 ticks_,
+                 mean,
+                 percentile(0.50),
+                 percentile(0.99),
+                 latencyMax_,
+                 ticks_ > 0 ? static_cast<double>(latencySum_) / static_cast<double>(ticks_) : 0.0);
+}
+
+void BotLink::append(std::string_view text)
+{
+    outBuffer_.insert(outBuffer_.end(), text.begin(), text.end());
+}
+
+void BotLink::appendNumber(std::int64_t value)
+{
+    std::array<char, 24> digits{};
+    const auto [end, error] = std::to_chars(digits.data(), digits.data() + digits.size(), value);
+    (void)error;
+    outBuffer_.insert(outBuffer_.end(), digits.data(), end);
+}
+
+void BotLink::appendPosition(const Board& board, Cell cell)
+{
+    const GridPos pos = board.position(cell);
+    append(" ");
+    appendNumber(pos.x);
+    append(" ");
+    appendNumber(pos.y);
+}
+
+void BotLink::flush()
+{
+#ifdef SNAKE_HAS_BOT_LINK
+    // Cala wymiana idzie jednym wywolaniem write, jesli jadro przyjmie wszystko naraz.
+    std::size_t written = 0;
+    while (written < outBuffer_.size())
+    {
+        const ssize_t result = write(output_, outBuffer_.data() + written, outBuffer_.size() - written);
+        if (result == -1)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            throw std::runtime_error("Failed to write to bot");
+        }
+        written += static_cast<std::size_t>(result);
+    }
+#endif
+    outBuffer_.clear();
+}
+
+bool BotLink::readLine(std::string_view& line)
+{
+#ifdef SNAKE_HAS_BOT_LINK
+    while (true)
+    {
+        const auto begin = inBuffer_.begin() + static_cast<std::ptrdiff_t>(inBegin_);
+        const auto end = inBuffer_.begin() + static_cast<std::ptrdiff_t>(inEnd_);
+        const auto newline = std::find(begin, end, '\n');
+        if (newline != end)
+        {
+            std::size_t length = static_cast<std::size_t>(newline - begin);
+            // Boty z Windows koncza linie znakami \r\n.
+            if (length > 0 && *(newline - 1) == '\r')
+            {
+                --length;
+            }
+            line = std::string_view(&*begin, length);
+            inBegin_ = static_cast<std::size_t>(newline - inBuffer_.begin()) + 1;
+            return true;
+        }
+
+        // Niepelna linie przesuwamy na poczatek bufora przed kolejnym odczytem.
+        std::copy(begin, end, inBuffer_.begin());
+        inEnd_ -= inBegin_;
+        inBegin_ = 0;
+        if (inEnd_ == inBuffer_.size())
+        {
+            throw std::runtime_error("Bot line is too long");
+        }
+
+        const ssize_t result = read(input_, inBuffer_.data() + inEnd_, inBuffer_.size() - inEnd_);
+        if (result == -1 && errno == EINTR)
+        {
+            continue;
+        }
+        if (result <= 0)
+        {
+            return false;
+        }
+        inEnd_ += static_cast<std::size_t>(result);
+    }
+#else
+    (void)line;
+    return false;
+#endif
+}
+
+void BotLink::recordLatency(std::uint64_t micros)
+{
+    ++rounds_;
+    latencySum_ += micros;
+    latencyMax_ = std::max(latencyMax_, micros);
+    // Przedzial k obejmuje czasy ponizej 2^k mikrosekund.
+    const auto bucket = static_cast<std::size_t>(std::bit_width(micros));
+    ++latencyBuckets_[std::min(bucket, latencyBuckets_.size() - 1)];
+}
@@ -0,0 +1,372 @@
+#include "Checkpoint.hpp"
+
+#include "BinaryIO.hpp"
+#include "MappedFile.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <fstream>
+#include <print>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+constexpr std::array<char, 4> checkpointMagic{'S', 'N', 'K', 'C'};
+// Wersja 1 zawierala cala powtorke i stan ekranu.
+constexpr std::uint32_t checkpointVersion = 2;
+constexpr std::array<char, 4> journalMagic{'S', 'N', 'K', 'J'};
+constexpr std::uint32_t journalVersion = 1;
+constexpr std::uint32_t maxNameLength = 64;
+constexpr std::uint32_t maxMapPathLength = 4096;
+
+// Rekordy dziennika: kierunki kolejnych tikow albo klatka kluczowa.
+constexpr std::uint8_t directionsRecord = 'D';
+constexpr std::uint8_t keyframeRecord = 'K';
+
+// Wymusza zapis pliku na dysk przed podmiana (zanik zasilania kiosku).
+void syncFile(const std::filesystem::path& path)
+{
+#if defined(__unix__) || defined(__APPLE__)
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd != -1)
+    {
+        fsync(fd);
+        close(fd);
+    }
+#else
+    (void)path;
+#endif
+}
+
+void appendString(std::vector<std::byte>& output, std::string_view text)
+{
+    appendValue(output, static_cast<std::uint32_t>(text.size()));
+    appendValues(output, std::span<const char>(text));
+}
+
+std::string readString(ByteReader& input, std::uint32_t maxLength)
+{
+    const auto length = input.read<std::uint32_t>();
+    if (length > maxLength)
+    {
+        throw std::invalid_argument("Corrupted checkpoint string");
+    }
+    std::string text(length, '\0');
+    input.readInto(std::span<char>(text));
+    return text;
+}
+
+// Plansza i przedmioty, dla ktorych zapisano gre (wspolne dla zapisu i dziennika).
+void appendBoard(std::vector<std::byte>& output, const Replay& replay)
+{
+    appendValue(output, static_cast<std::int32_t>(replay.width));
+    appendValue(output, static_cast<std::int32_t>(replay.height));
+    appendString(output, replay.map);
+    appendValue(output, static_cast<std::int32_t>(replay.foodCount));
+    appendValue(output, static_cast<std::int32_t>(replay.powerUps));
+}
+
+void readBoard(ByteReader& input, Replay& replay)
+{
+    replay.width = input.read<std::int32_t>();
+    replay.height = input.read<std::int32_t>();
+    replay.map = readString(input, maxMapPathLength);
+    replay.foodCount = input.read<std::int32_t>();
+    replay.powerUps = input.read<std::int32_t>();
+}
+
+bool sameBoard(const Replay& lhs, const Replay& rhs)
+{
+    return lhs.width == rhs.width && lhs.height == rhs.height && lhs.map == rhs.map &&
+           lhs.foodCount == rhs.foodCount && lhs.powerUps == rhs.powerUps;
+}
+
+std::span<const std::byte> fileBytes(const MappedFile& file)
+{
+    return std::as_bytes(std::span<const char>(file.data()));
+}
+
+// Dopisuje do pliku dziennika albo zaczyna go od nowa.
+void writeJournal(const std::filesystem::path& path, std::span<const std::byte> bytes, bool restart)
+{
+    std::ofstream output(path, std::ios::binary | (restart ? std::ios::trunc : std::ios::app));
+    output.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    output.flush();
+    if (!output)
+    {
+        throw std::runtime_error("Failed to write checkpoint journal: " + path.string());
+    }
+}
+} // namespace
+
+CheckpointWriter::CheckpointWriter(std::filesystem::path path)
+    : path_(std::move(path)), journalPath_(std::filesystem::path(path_).replace_extension(".journal"))
+{
+    writer_ = std::jthread([this](std::stop_token stopToken) { writerLoop(stopToken); });
+}
+
+CheckpointWriter::~CheckpointWriter()
+{
+    // Watek w tle konczy oczekujacy zapis przed wyjsciem.
+    writer_.request_stop();
+    writer_.join();
+}
+
+const std::filesystem::path& CheckpointWriter::path() const
+{
+    return path_;
+}
+
+void CheckpointWriter::save(const SessionState& session, const Simulation& simulation, const Replay& replay)
+{
+    Job job;
+
+    // Nowa gra albo blad poprzedniego zapisu: dziennik od naglowka i calej powtorki.
+    if (failed_.exchange(false) || journalSeed_ != replay.seed || replay.directions.size() < journalDirections_ ||
+        replay.keyframes.size() < journalKeyframes_)
+    {
+        job.restartJournal = true;
+        journalSeed_ = replay.seed;
+        journalDirections_ = 0;
+        journalKeyframes_ = 0;
+
+        appendValue(job.journal, journalMagic);
+        appendValue(job.journal, journalVersion);
+        appendValue(job.journal, replay.seed);
+        appendBoard(job.journal, replay);
+    }
+
+    if (replay.directions.size() > journalDirections_)
+    {
+        const auto directions = std::span<const Direction>(replay.directions).subspan(journalDirections_);
+        job.journal.push_back(static_cast<std::byte>(directionsRecord));
+        appendValue(job.journal, static_cast<std::uint64_t>(directions.size()));
+        appendValues(job.journal, directions);
+        journalDirections_ = replay.directions.size();
+    }
+    for (; journalKeyframes_ < replay.keyframes.size(); ++journalKeyframes_)
+    {
+        const Keyframe& keyframe = replay.keyframes[journalKeyframes_];
+        job.journal.push_back(static_cast<std::byte>(keyframeRecord));
+        appendValue(job.journal, keyframe.tick);
+        appendValue(job.journal, keyframe.size);
+        const std::span<const std::byte> data(replay.keyframeData);
+        appendValues(job.journal, data.subspan(keyframe.offset, keyframe.size));
+    }
+
+    // Sam zapis: sesja, plansza, dlugosc powtorki w dzienniku i stan symulacji.
+    std::vector<std::byte>& output = job.checkpoint;
+    appendValue(output, checkpointMagic);
+    appendValue(output, checkpointVersion);
+    appendValue(output, session.pendingDirection);
+    appendString(output, session.playerName);
+    appendBoard(output, replay);
+    appendValue(output, static_cast<std::uint64_t>(journalDirections_));
+    appendValue(output, static_cast<std::uint64_t>(journalKeyframes_));
+    simulation.writeState(output);
+
+    queue(std::move(job));
+}
+
+void CheckpointWriter::discard()
+{
+    journalSeed_.reset();
+    journalDirections_ = 0;
+    journalKeyframes_ = 0;
+
+    Job job;
+    job.remove = true;
+    queue(std::move(job));
+}
+
+void CheckpointWriter::resumed(const Replay& replay)
+{
+    journalSeed_ = replay.seed;
+    journalDirections_ = replay.directions.size();
+    journalKeyframes_ = replay.keyframes.size();
+}
+
+void CheckpointWriter::queue(Job job)
+{
+    {
+        const std::lock_guard lock(mutex_);
+        // Zapis czekajacy na watek jest zastepowany, ale jego czesc dziennika przechodzi dalej.
+        if (pending_ && !pending_->remove && !job.remove && !job.restartJournal)
+        {
+            pending_->journal.insert(pending_->journal.end(), job.journal.begin(), job.journal.end());
+            pending_->checkpoint = std::move(job.checkpoint);
+        }
+        else
+        {
+            pending_ = std::move(job);
+        }
+    }
+    ready_.notify_one();
+}
+
+void CheckpointWriter::writerLoop(std::stop_token stopToken)
+{
+    while (true)
+    {
+        std::optional<Job> job;
+        {
+            std::unique_lock lock(mutex_);
+            ready_.wait(lock, stopToken, [this] { return pending_.has_value(); });
+            if (!pending_)
+            {
+                return;
+            }
+            job = std::move(pending_);
+            pending_.reset();
+        }
+
+        try
+        {
+            write(*job);
+        }
+        catch (const std::exception& ex)
+        {
+            // Gra toczy sie dalej; kolejny zapis zacznie dziennik od nowa.
+            failed_.store(true);
+            std::println(stderr, "Checkpoint not saved: {}", ex.what());
+        }
+    }
+}
+
+void CheckpointWriter::write(const Job& job)
+{
+    if (job.remove)
+    {
+        std::filesystem::remove(path_);
+        std::filesystem::remove(journalPath_);
+        return;
+    }
+
+    // Dziennik trafia na dysk przed zapisem, ktory na niego wskazuje.
+    writeJournal(journalPath_, job.journal, job.restartJournal);
+    syncFile(journalPath_);
+
+    auto temporary = path_;
+    temporary += ".tmp";
+    {
+        std::ofstream output(temporary, std::ios::binary | std::ios::trunc);
+        output.write(reinterpret_cast<const char*>(job.checkpoint.data()),
+                     static_cast<std::streamsize>(job.checkpoint.size()));
+        output.flush();
+        if (!output)
+        {
+            throw std::runtime_error("Failed to write checkpoint: " + temporary.string());
+        }
+    }
+
+    syncFile(temporary);
+    std::filesystem::rename(temporary, path_);
+}
+
+LoadedCheckpoint loadCheckpoint(const std::filesystem::path& path, Simulation& simulation, const std::string& map)
+{
+    const MappedFile file(path);
+    const auto bytes = fileBytes(file);
+    ByteReader input(bytes);
+
+    if (input.read<std::array<char, 4>>() != checkpointMagic || input.read<std::uint32_t>() != checkpointVersion)
+    {
+        throw std::invalid_argument("Not a supported checkpoint: " + path.string());
+    }
+
+    LoadedCheckpoint loaded;
+    loaded.session.pendingDirection = input.read<Direction>();
+    loaded.session.playerName = readString(input, maxNameLength);
+    if (loaded.session.pendingDirection > Direction::Right)
+    {
+        throw std::invalid_argument("Corrupted checkpoint header: " + path.string());
+    }
+
+    Replay& replay = loaded.replay;
+    readBoard(input, replay);
+    const Board& board = simulation.board();
+    const ItemOptions& items = simulation.food().options();
+    if (replay.width != board.width() || replay.height != board.height() || replay.map != map ||
+        replay.foodCount != items.foodCount || replay.powerUps != items.powerUps)
+    {
+        throw std::invalid_argument("Checkpoint was saved for a different board: " + path.string());
+    }
+    const auto journalDirections = input.read<std::uint64_t>();
+    const auto journalKeyframes = input.read<std::uint64_t>();
+
+    // Dziennik moze miec na koncu rekordy zapisu przerwanego przed podmiana pliku; pomijamy je.
+    const auto journalPath = std::filesystem::path(path).replace_extension(".journal");
+    std::size_t journalLength = 0;
+    {
+        const MappedFile journalFile(journalPath);
+        const auto journalBytes = fileBytes(journalFile);
+        ByteReader journal(journalBytes);
+
+        if (journal.read<std::array<char, 4>>() != journalMagic || journal.read<std::uint32_t>() != journalVersion)
+        {
+            throw std::invalid_argument("Not a supported checkpoint journal: " + journalPath.string());
+        }
+        replay.seed = journal.read<std::uint32_t>();
+        Replay journalBoard;
+        readBoard(journal, journalBoard);
+        if (!sameBoard(journalBoard, replay))
+        {
+            throw std::invalid_argument("Checkpoint journal belongs to a different game: " + journalPath.string());
+        }
+
+        while (replay.directions.size() < journalDirections || replay.keyframes.size() < journalKeyframes)
+        {
+            const auto type = journal.read<std::uint8_t>();
+            const auto count = journal.read<std::uint64_t>();
+            if (type == directionsRecord && count <= journalDirections - replay.directions.size())
+            {
+                const std::size_t offset = replay.directions.size();
+                replay.directions.resize(offset + count);
+                journal.readInto(std::span<Direction>(replay.directions).subspan(offset));
+            }
+            else if (type == keyframeRecord && replay.keyframes.size() < journalKeyframes)
+            {
+                // Dla klatki kluczowej count to jej tik.
+                const auto size = journal.read<std::uint64_t>();
+                if (size > journal.remaining())
+                {
+                    throw std::invalid_argument("Truncated checkpoint journal: " + journalPath.string());
+                }
+                const std::size_t offset = replay.keyframeData.size();
+                replay.keyframes.push_back({count, offset, size});
+                replay.keyframeData.resize(offset + size);
+                journal.readInto(std::span<std::byte>(replay.keyframeData).subspan(offset));
+            }
+            else
+            {
+                throw std::invalid_argument("Corrupted checkpoint journal: " + journalPath.string());
+            }
+        }
+
+        const auto validKeyframe = [&](const Keyframe& keyframe) { return keyframe.tick <= replay.directions.size(); };
+        if (std::ranges::any_of(replay.directions, [](Direction direction) { return direction > Direction::Right; }) ||
+            !std::ranges::is_sorted(replay.keyframes, {}, &Keyframe::tick) ||
+            !std::ranges::all_of(replay.keyframes, validKeyframe))
+        {
+            throw std::invalid_argument("Corrupted checkpoint journal: " + journalPath.string());
+        }
+        journalLength = journalBytes.size() - journal.remaining();
+    }
+
+    // Stan na koncu, zeby blad w plikach zostawial symulacje bez zmian.
+    simulation.readState(bytes.subspan(bytes.size() - input.remaining()));
+    if (std::filesystem::file_size(journalPath) > journalLength)
+    {
+        std::filesystem::resize_file(journalPath, journalLength);
+    }
+    return loaded;
+}
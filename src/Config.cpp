@@ -42,7 +42,7 @@ void validatePositive(const std::string& key, int value)
 Config loadConfig(const std::filesystem::path& path)
 {
     // Start od ustawien domyslnych.
-    Config config{defaultWidth, defaultHeight, defaultTileSize, defaultTickMs};
+    Config config{defaultWidth, defaultHeight, defaultTileSize, defaultTickMs, 1, 0, {}};
 
     if (!std::filesystem::exists(path))
     {
@@ -77,6 +77,18 @@ Config loadConfig(const std::filesystem::path& path)
         trim(key);
         trim(valueText);
 
+        // Jedyny klucz tekstowy.
+        if (key == "map")
+        {
+            if (valueText.empty())
+            {
+                throw std::invalid_argument("Config value for map must not be empty");
+            }
+            config.map = valueText;
+            seenKeys.insert(key);
+            continue;
+        }
+
         int value = 0;
         try
         {
@@ -107,6 +119,19 @@ Config loadConfig(const std::filesystem::path& path)
             validatePositive(key, value);
             config.tickMs = value;
         }
+        else if (key == "food_count")
+        {
+            validatePositive(key, value);
+            config.foodCount = value;
+        }
+        else if (key == "power_ups")
+        {
+            if (value < 0)
+            {
+                throw std::invalid_argument("Config value for power_ups must not be negative");
+            }
+            config.powerUps = value;
+        }
         else
         {
             throw std::invalid_argument("Unknown config key: " + key);
@@ -115,8 +140,9 @@ Config loadConfig(const std::filesystem::path& path)
         seenKeys.insert(key);
     }
 
-    const bool allKeysPresent = seenKeys.contains("width") && seenKeys.contains("height") &&
-                                seenKeys.contains("tile_size") && seenKeys.contains("tick_ms");
+    // Przy mapie rozmiar planszy wynika z pliku mapy.
+    const bool sizePresent = seenKeys.contains("map") || (seenKeys.contains("width") && seenKeys.contains("height"));
+    const bool allKeysPresent = sizePresent && seenKeys.contains("tile_size") && seenKeys.contains("tick_ms");
 
     if (!allKeysPresent)
     {
@@ -0,0 +1,227 @@
+#include "EndlessGame.hpp"
+
+#include "BoardRenderer.hpp"
+#include "Input.hpp"
+#include "Random.hpp"
+
+#include <SFML/Window/Event.hpp>
+
+#include <format>
+#include <optional>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+const sf::Color wallColor(90, 90, 110);
+const sf::Color snakeColor(30, 160, 60);
+} // namespace
+
+EndlessGame::EndlessGame(const Config& config, const std::filesystem::path& dataDir)
+    : config_(config),
+      simulation_(std::make_unique<EndlessSimulation>(Random::makeSeed())),
+      window_(sf::VideoMode({static_cast<unsigned int>(config.width * config.tileSize),
+                             static_cast<unsigned int>(config.height * config.tileSize)}),
+              "Snake - endless"),
+      scoreText_(font_, "", static_cast<unsigned int>(config.tileSize)),
+      statusText_(font_, "", static_cast<unsigned int>(config.tileSize + 6))
+{
+    window_.setFramerateLimit(60);
+    tickSeconds_ = static_cast<float>(config_.tickMs) / 1000.F;
+
+    const auto fontPath = dataDir / fontFile;
+    if (!font_.openFromFile(fontPath))
+    {
+        throw std::runtime_error("Failed to load font: " + fontPath.string());
+    }
+
+    scoreText_.setFillColor(sf::Color::White);
+    scoreText_.setPosition({4.F, 2.F});
+    statusText_.setFillColor(sf::Color(250, 220, 70));
+    updateTexts();
+}
+
+void EndlessGame::run()
+{
+    sf::Clock clock;
+
+    while (window_.isOpen())
+    {
+        handleEvents();
+        update(clock.restart().asSeconds());
+        render();
+    }
+}
+
+void EndlessGame::handleEvents()
+{
+    while (const std::optional<sf::Event> event = window_.pollEvent())
+    {
+        if (event->is<sf::Event::Closed>())
+        {
+            window_.close();
+        }
+        else if (const auto* key = event->getIf<sf::Event::KeyPressed>())
+        {
+            if (key->code == sf::Keyboard::Key::Escape)
+            {
+                window_.close();
+            }
+            else if (key->code == sf::Keyboard::Key::R)
+            {
+                restart();
+            }
+            else if (key->code == sf::Keyboard::Key::P && state_ != State::GameOver)
+            {
+                state_ = state_ == State::Paused ? State::Running : State::Paused;
+                accumulator_ = 0.F;
+                updateTexts();
+            }
+            else
+            {
+                const Direction requested = directionFromKey(key->code);
+                if (!areOpposite(simulation_->direction(), requested))
+                {
+                    pendingDirection_ = requested;
+                }
+            }
+        }
+    }
+}
+
+void EndlessGame::update(float dt)
+{
+    if (state_ != State::Running)
+    {
+        return;
+    }
+
+    accumulator_ += dt;
+    while (accumulator_ >= tickSeconds_)
+    {
+        accumulator_ -= tickSeconds_;
+        const StepResult result = simulation_->step(pendingDirection_);
+
+        if (result == StepResult::HitWall || result == StepResult::HitSelf)
+        {
+            state_ = State::GameOver;
+            updateTexts();
+            return;
+        }
+        if (result == StepResult::Ate)
+        {
+            updateTexts();
+        }
+    }
+}
+
+void EndlessGame::render()
+{
+    window_.clear(sf::Color(18, 18, 18));
+
+    // Kamera w srodku glowy weza.
+    const auto tile = static_cast<float>(config_.tileSize);
+    const sf::Vector2f viewSize = window_.getDefaultView().getSize();
+    const GridPos head = simulation_->head();
+    const sf::View camera({(static_cast<float>(head.x) + 0.5F) * tile, (static_cast<float>(head.y) + 0.5F) * tile},
+                          viewSize);
+
+    // Zakres widocznych pol z marginesem jednego pola.
+    const int halfWidth = static_cast<int>(viewSize.x / tile / 2.F) + 1;
+    const int halfHeight = static_cast<int>(viewSize.y / tile / 2.F) + 1;
+    const GridPos minPos{head.x - halfWidth, head.y - halfHeight};
+    const GridPos maxPos{head.x + halfWidth, head.y + halfHeight};
+
+    tiles_.clear();
+    const World& world = simulation_->world();
+    const ChunkKey minChunk = chunkKeyOf(minPos);
+    const ChunkKey maxChunk = chunkKeyOf(maxPos);
+
+    // Przechodzimy po widocznych fragmentach, nie po pojedynczych polach.
+    for (int cy = minChunk.y; cy <= maxChunk.y; ++cy)
+    {
+        for (int cx = minChunk.x; cx <= maxChunk.x; ++cx)
+        {
+            const Chunk* chunk = world.find({cx, cy});
+            if (chunk == nullptr)
+            {
+                continue;
+            }
+
+            for (int ly = 0; ly < chunkSize; ++ly)
+            {
+                for (int lx = 0; lx < chunkSize; ++lx)
+                {
+                    const GridPos pos{cx * chunkSize + lx, cy * chunkSize + ly};
+                    if (pos.x < minPos.x || pos.x > maxPos.x || pos.y < minPos.y || pos.y > maxPos.y)
+                    {
+                        continue;
+                    }
+
+                    if (!chunk->terrain.passable(chunk->terrain.cell({lx, ly})))
+                    {
+                        appendTile(pos, wallColor);
+                    }
+                    else if (chunk->food.test(static_cast<std::size_t>(ly * chunkSize + lx)))
+                    {
+                        appendTile(pos, itemColor(ItemKind::Food));
+                    }
+                }
+            }
+        }
+    }
+
+    for (const GridPos& segment : simulation_->body())
+    {
+        if (segment.x >= minPos.x && segment.x <= maxPos.x && segment.y >= minPos.y && segment.y <= maxPos.y)
+        {
+            appendTile(segment, snakeColor);
+        }
+    }
+
+    window_.setView(camera);
+    window_.draw(tiles_);
+    window_.setView(window_.getDefaultView());
+
+    window_.draw(scoreText_);
+    if (state_ != State::Running)
+    {
+        window_.draw(statusText_);
+    }
+
+    window_.display();
+}
+
+void EndlessGame::restart()
+{
+    // Nowy swiat z nowym ziarnem.
+    simulation_ = std::make_unique<EndlessSimulation>(Random::makeSeed());
+    pendingDirection_ = Direction::Right;
+    accumulator_ = 0.F;
+    state_ = State::Running;
+    updateTexts();
+}
+
+void EndlessGame::updateTexts()
+{
+    scoreText_.setString(
+        std::format("Score: {}  Chunks: {}", simulation_->score(), simulation_->world().loadedChunks()));
+
+    if (state_ == State::Paused)
+    {
+        statusText_.setString("PAUSED");
+    }
+    else if (state_ == State::GameOver)
+    {
+        statusText_.setString("GAME OVER - R to restart");
+    }
+
+    const sf::Vector2f viewSize = window_.getDefaultView().getSize();
+    centerText(statusText_, {viewSize.x / 2.F, viewSize.y / 2.F});
+}
+
+void EndlessGame::appendTile(const GridPos& pos, const sf::Color& color)
+{
+    const auto tile = static_cast<float>(config_.tileSize);
+    appendQuad(tiles_, {static_cast<float>(pos.x) * tile, static_cast<float>(pos.y) * tile}, {tile, tile}, color);
+}
@@ -0,0 +1,77 @@
+#include "EndlessSimulation.hpp"
+
+namespace
+{
+constexpr int initialLength = 3;
+} // namespace
+
+EndlessSimulation::EndlessSimulation(std::uint32_t seed)
+    : world_(seed)
+{
+    // Start w (0, 0) w prawo, ogon na osi X.
+    for (int i = 0; i < initialLength; ++i)
+    {
+        body_.push_back({-i, 0});
+        world_.setSnake(body_.back(), true);
+    }
+}
+
+StepResult EndlessSimulation::step(Direction direction)
+{
+    direction_ = direction;
+    world_.update(head(), direction_);
+
+    const GridPos next = head() + directionOffset(direction_);
+    if (world_.blocked(next))
+    {
+        return StepResult::HitWall;
+    }
+
+    const bool grow = world_.takeFood(next);
+    if (!grow)
+    {
+        // Ogon zwalnia pole przed wejsciem glowy, jak w Snake::move.
+        world_.setSnake(body_.back(), false);
+        body_.pop_back();
+    }
+
+    if (world_.snakeAt(next))
+    {
+        return StepResult::HitSelf;
+    }
+
+    body_.push_front(next);
+    world_.setSnake(next, true);
+
+    if (grow)
+    {
+        ++score_;
+        return StepResult::Ate;
+    }
+    return StepResult::Moved;
+}
+
+const World& EndlessSimulation::world() const
+{
+    return world_;
+}
+
+const std::deque<GridPos>& EndlessSimulation::body() const
+{
+    return body_;
+}
+
+GridPos EndlessSimulation::head() const
+{
+    return body_.front();
+}
+
+Direction EndlessSimulation::direction() const
+{
+    return direction_;
+}
+
+int EndlessSimulation::score() const
+{
+    return score_;
+}
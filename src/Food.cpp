@@ -1,35 +1,354 @@
 #include "Food.hpp"
 
-#include <vector>
+#include "BinaryIO.hpp"
+#include "PerfCounters.hpp"
+#include "Tracer.hpp"
 
-const GridPos& Food::position() const
+#include <algorithm>
+#include <stdexcept>
+
+namespace
+{
+// Czasy bonusow w tikach.
+constexpr std::uint64_t powerUpLifetime = 150;
+constexpr std::uint64_t powerUpDelay = 60;
+// Proby losowania pola przed przejsciem do wyszukiwania wolnego pola wierszami.
+constexpr int randomAttempts = 16;
+
+constexpr std::array<ItemKind, 3> powerUpKinds{ItemKind::Speed, ItemKind::Shrink, ItemKind::Ghost};
+
+// Liczba slotow; sprawdzana przed alokacja tablic.
+std::size_t slotCount(const Board& board, const ItemOptions& options)
+{
+    if (options.foodCount < 1 || options.powerUps < 0 ||
+        static_cast<std::size_t>(options.foodCount) + static_cast<std::size_t>(options.powerUps) > board.passableCount())
+    {
+        throw std::invalid_argument("Food and power-up counts must fit on the board");
+    }
+    return static_cast<std::size_t>(options.foodCount) + static_cast<std::size_t>(options.powerUps);
+}
+} // namespace
+
+Food::Food(const Board& board, const ItemOptions& options)
+    : options_(options),
+      items_(slotCount(board, options)),
+      slotAt_(board.cellCount(), none),
+      timerNext_(items_.size(), none),
+      timerPrev_(items_.size(), none),
+      scheduled_(items_.size(), 0)
+{
+    due_.reserve(items_.size());
+    wheel_.fill(none);
+}
+
+Cell Food::position() const
+{
+    return items_.front().cell;
+}
+
+std::span<const Item> Food::items() const
+{
+    return items_;
+}
+
+const ItemOptions& Food::options() const
+{
+    return options_;
+}
+
+void Food::reset(const Board& board, const Snake& snake, Random& random)
+{
+    for (std::size_t slot = 0; slot < items_.size(); ++slot)
+    {
+        remove(slot);
+        unschedule(slot);
+    }
+
+    for (std::size_t slot = 0; slot < items_.size(); ++slot)
+    {
+        Item& item = items_[slot];
+        if (slot < static_cast<std::size_t>(options_.foodCount))
+        {
+            item.kind = ItemKind::Food;
+            Cell cell{};
+            if (randomFreeCell(board, snake, random, cell))
+            {
+                put(slot, cell);
+            }
+        }
+        else
+        {
+            // Bonusy wchodza po kolei, a nie wszystkie w jednym tiku.
+            item.kind = ItemKind::Speed;
+            schedule(slot, powerUpDelay + (slot - static_cast<std::size_t>(options_.foodCount)));
+        }
+    }
+}
+
+void Food::take(Cell cell, const Board& board, const Snake& snake, Random& random, std::uint64_t tick)
+{
+    const std::int32_t found = slotAt_[cell];
+    if (found < 0)
+    {
+        return;
+    }
+
+    const auto slot = static_cast<std::size_t>(found);
+    remove(slot);
+    if (items_[slot].kind != ItemKind::Food)
+    {
+        unschedule(slot);
+        schedule(slot, tick + powerUpDelay);
+        return;
+    }
+
+    Cell next{};
+    if (randomFreeCell(board, snake, random, next))
+    {
+        put(slot, next);
+    }
+}
+
+void Food::advance(const Board& board, const Snake& snake, Random& random, std::uint64_t tick)
+{
+    // Kubelek zawiera tez sloty z kolejnych obrotow kola; obslugujemy tylko te na ten tik,
+    // po numerze slotu, zeby gra wznowiona z zapisu losowala w tej samej kolejnosci.
+    due_.clear();
+    for (std::int32_t current = wheel_[tick % wheelSize]; current != none;
+         current = timerNext_[static_cast<std::size_t>(current)])
+    {
+        if (items_[static_cast<std::size_t>(current)].due == tick)
+        {
+            due_.push_back(static_cast<std::size_t>(current));
+        }
+    }
+    std::ranges::sort(due_);
+
+    for (const std::size_t slot : due_)
+    {
+        unschedule(slot);
+        Item& item = items_[slot];
+        if (item.active)
+        {
+            remove(slot);
+            schedule(slot, tick + powerUpDelay);
+            continue;
+        }
+
+        Cell cell{};
+        if (!randomFreeCell(board, snake, random, cell))
+        {
+            schedule(slot, tick + powerUpDelay);
+            continue;
+        }
+        const int kind = random.uniformInt(0, static_cast<int>(powerUpKinds.size()) - 1);
+        item.kind = powerUpKinds[static_cast<std::size_t>(kind)];
+        put(slot, cell);
+        schedule(slot, tick + powerUpLifetime);
+    }
+}
+
+void Food::writeState(std::vector<std::byte>& output) const
+{
+    appendValue(output, static_cast<std::uint32_t>(items_.size()));
+    for (const Item& item : items_)
+    {
+        appendValue(output, item.cell);
+        appendValue(output, item.kind);
+        appendValue(output, static_cast<std::uint8_t>(item.active));
+        appendValue(output, item.due);
+    }
+}
+
+std::vector<Item> Food::readState(ByteReader& input)
+{
+    const auto count = input.read<std::uint32_t>();
+    // Kazdy slot zajmuje w zapisie 14 bajtow.
+    if (count > input.remaining() / 14)
+    {
+        throw std::invalid_argument("Corrupted item count in saved state");
+    }
+
+    std::vector<Item> items(count);
+    for (Item& item : items)
+    {
+        item.cell = input.read<Cell>();
+        item.kind = input.read<ItemKind>();
+        item.active = input.read<std::uint8_t>() != 0;
+        item.due = input.read<std::uint64_t>();
+    }
+    return items;
+}
+
+void Food::restore(std::span<const Item> items,
+                   const Board& board,
+                   std::span<const Cell> sortedBody,
+                   std::uint64_t tick)
 {
-    return position_;
+    if (items.size() != items_.size())
+    {
+        throw std::invalid_argument("Saved state has different food and power-up counts");
+    }
+
+    std::vector<Cell> cells;
+    for (std::size_t slot = 0; slot < items.size(); ++slot)
+    {
+        const Item& item = items[slot];
+        const bool food = slot < static_cast<std::size_t>(options_.foodCount);
+        const bool validKind = food ? item.kind == ItemKind::Food
+                                    : item.kind > ItemKind::Food && item.kind <= ItemKind::Ghost;
+        // Zaplanowany tik bonusu musi byc w przyszlosci, inaczej kolo czasu go pominie.
+        if (!validKind || (!food && item.due <= tick))
+        {
+            throw std::invalid_argument("Corrupted item in saved state");
+        }
+        if (item.active)
+        {
+            if (item.cell >= board.cellCount() || !board.passable(item.cell) ||
+                std::ranges::binary_search(sortedBody, item.cell))
+            {
+                throw std::invalid_argument("Corrupted item cell in saved state");
+            }
+            cells.push_back(item.cell);
+        }
+    }
+    std::ranges::sort(cells);
+    if (std::ranges::adjacent_find(cells) != cells.end())
+    {
+        throw std::invalid_argument("Overlapping items in saved state");
+    }
+
+    for (std::size_t slot = 0; slot < items_.size(); ++slot)
+    {
+        remove(slot);
+        unschedule(slot);
+    }
+    for (std::size_t slot = 0; slot < items.size(); ++slot)
+    {
+        const Item& item = items[slot];
+        items_[slot].kind = item.kind;
+        items_[slot].cell = item.cell;
+        if (item.active)
+        {
+            put(slot, item.cell);
+        }
+        if (item.kind != ItemKind::Food)
+        {
+            schedule(slot, item.due);
+        }
+    }
 }
 
-void Food::respawn(const Board& board, const Snake& snake, Random& random)
+void Food::place(Cell cell)
 {
-    // Zbieramy wszystkie wolne pola planszy
-    std::vector<GridPos> freeFields;
-    freeFields.reserve(static_cast<std::size_t>(board.width() * board.height()));
+    remove(0);
+    put(0, cell);
+}
 
+void Food::put(std::size_t slot, Cell cell)
+{
+    Item& item = items_[slot];
+    item.cell = cell;
+    item.active = true;
+    slotAt_[cell] = static_cast<std::int32_t>(slot);
+    ++activeItems_;
+}
+
+void Food::remove(std::size_t slot)
+{
+    Item& item = items_[slot];
+    if (!item.active)
+    {
+        return;
+    }
+    // Pole zostaje w slocie (ostatnie polozenie jedzenia przy pelnej planszy).
+    item.active = false;
+    slotAt_[item.cell] = none;
+    --activeItems_;
+}
+
+bool Food::randomFreeCell(const Board& board, const Snake& snake, Random& random, Cell& result) const
+{
+    const PerfScope perfScope(PerfPhase::Respawn);
+    const TraceScope traceScope("respawn");
+
+    // Wolnych pol jest tyle co pol bez scian minus pola pod wezem i przedmioty.
+    const std::size_t openCells = board.passableCount();
+    const std::size_t taken = snake.occupiedCells() + activeItems_;
+    if (taken >= openCells)
+    {
+        return false;
+    }
+
+    const auto isFree = [&](Cell cell) { return board.passable(cell) && !snake.occupies(cell) && slotAt_[cell] < 0; };
+
+    // Przy wielu przedmiotach zwykle trafiamy wolne pole od razu, bez przegladania planszy.
+    // Jedno jedzenie losuje jak dotad, wiec stare powtorki i zapisy odtwarzaja sie tak samo.
+    if (items_.size() > 1)
+    {
+        const int lastCell = static_cast<int>(board.cellCount()) - 1;
+        for (int attempt = 0; attempt < randomAttempts; ++attempt)
+        {
+            const auto cell = static_cast<Cell>(random.uniformInt(0, lastCell));
+            if (isFree(cell))
+            {
+                result = cell;
+                return true;
+            }
+        }
+    }
+
+    // Losujemy numer wolnego pola bez budowania listy i szukamy go w kolejnosci wierszy.
+    int remaining = random.uniformInt(0, static_cast<int>(openCells - taken) - 1);
     for (int y = 0; y < board.height(); ++y)
     {
-        for (int x = 0; x < board.width(); ++x)
+        const Cell rowStart = board.cell({0, y});
+        for (Cell cell = rowStart; cell < rowStart + static_cast<Cell>(board.width()); ++cell)
         {
-            GridPos pos{x, y};
-            if (!snake.occupies(pos))
+            if (isFree(cell) && remaining-- == 0)
             {
-                freeFields.push_back(pos);
+                result = cell;
+                return true;
             }
         }
     }
+    return false;
+}
+
+void Food::schedule(std::size_t slot, std::uint64_t due)
+{
+    items_[slot].due = due;
+    std::int32_t& head = wheel_[due % wheelSize];
+    timerPrev_[slot] = none;
+    timerNext_[slot] = head;
+    if (head != none)
+    {
+        timerPrev_[static_cast<std::size_t>(head)] = static_cast<std::int32_t>(slot);
+    }
+    head = static_cast<std::int32_t>(slot);
+    scheduled_[slot] = 1;
+}
 
-    if (freeFields.empty())
+void Food::unschedule(std::size_t slot)
+{
+    if (scheduled_[slot] == 0)
     {
         return;
     }
 
-    const int index = random.uniformInt(0, static_cast<int>(freeFields.size()) - 1);
-    position_ = freeFields[static_cast<std::size_t>(index)];
+    const std::int32_t prev = timerPrev_[slot];
+    const std::int32_t next = timerNext_[slot];
+    if (prev == none)
+    {
+        wheel_[items_[slot].due % wheelSize] = next;
+    }
+    else
+    {
+        timerNext_[static_cast<std::size_t>(prev)] = next;
+    }
+    if (next != none)
+    {
+        timerPrev_[static_cast<std::size_t>(next)] = prev;
+    }
+    scheduled_[slot] = 0;
 }
@@ -0,0 +1,217 @@
+#include "FrameExporter.hpp"
+
+#include "BoardRenderer.hpp"
+#include "LevelMap.hpp"
+#include "ReplayPlayer.hpp"
+
+#include <SFML/Graphics.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <format>
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace
+{
+// Klatka czekajaca na zakodowanie.
+struct FrameJob
+{
+    sf::Image image;
+    std::filesystem::path path;
+    bool raw{false};
+};
+
+void encodeFrame(const FrameJob& job)
+{
+    if (!job.raw)
+    {
+        if (!job.image.saveToFile(job.path))
+        {
+            throw std::runtime_error("Failed to write frame: " + job.path.string());
+        }
+        return;
+    }
+
+    std::ofstream output(job.path, std::ios::binary | std::ios::trunc);
+    const sf::Vector2u size = job.image.getSize();
+    output.write(reinterpret_cast<const char*>(job.image.getPixelsPtr()),
+                 static_cast<std::streamsize>(std::size_t{size.x} * size.y * 4));
+    if (!output)
+    {
+        throw std::runtime_error("Failed to write frame: " + job.path.string());
+    }
+}
+
+// Ograniczona kolejka i pula watkow kodujacych klatki.
+class EncoderPool
+{
+public:
+    EncoderPool(unsigned int workers, std::size_t queueLimit)
+        : queueLimit_(std::max<std::size_t>(queueLimit, 1))
+    {
+        for (unsigned int i = 0; i < workers; ++i)
+        {
+            workers_.emplace_back([this] { workerLoop(); });
+        }
+    }
+
+    EncoderPool(const EncoderPool&) = delete;
+    EncoderPool& operator=(const EncoderPool&) = delete;
+
+    ~EncoderPool()
+    {
+        finish();
+    }
+
+    // Blokuje tylko gdy kolejka jest pelna.
+    void submit(FrameJob job)
+    {
+        std::unique_lock lock(mutex_);
+        notFull_.wait(lock, [this] { return jobs_.size() < queueLimit_ || error_; });
+        if (error_)
+        {
+            std::rethrow_exception(error_);
+        }
+        jobs_.push_back(std::move(job));
+        notEmpty_.notify_one();
+    }
+
+    // Czeka na zapis wszystkich klatek i przekazuje blad z watku.
+    void finish()
+    {
+        {
+            std::lock_guard lock(mutex_);
+            stopping_ = true;
+        }
+        notEmpty_.notify_all();
+        workers_.clear();
+
+        if (error_ && !std::uncaught_exceptions())
+        {
+            std::rethrow_exception(std::exchange(error_, nullptr));
+        }
+    }
+
+private:
+    void workerLoop()
+    {
+        while (true)
+        {
+            FrameJob job;
+            {
+                std::unique_lock lock(mutex_);
+                notEmpty_.wait(lock, [this] { return !jobs_.empty() || stopping_; });
+                if (jobs_.empty())
+                {
+                    return;
+                }
+                job = std::move(jobs_.front());
+                jobs_.pop_front();
+            }
+            notFull_.notify_one();
+
+            try
+            {
+                encodeFrame(job);
+            }
+            catch (...)
+            {
+                std::lock_guard lock(mutex_);
+                if (!error_)
+                {
+                    error_ = std::current_exception();
+                }
+                notFull_.notify_all();
+            }
+        }
+    }
+
+    std::size_t queueLimit_{};
+    std::mutex mutex_;
+    std::condition_variable notEmpty_;
+    std::condition_variable notFull_;
+    std::deque<FrameJob> jobs_;
+    std::exception_ptr error_;
+    bool stopping_{false};
+    std::vector<std::jthread> workers_;
+};
+} // namespace
+
+ExportStats exportReplay(const Replay& replay,
+                         const Config& config,
+                         const std::filesystem::path& dataDir,
+                         const ExportOptions& options)
+{
+    const auto start = std::chrono::steady_clock::now();
+    std::filesystem::create_directories(options.outputDir);
+
+    sf::Font font;
+    const auto fontPath = dataDir / fontFile;
+    if (!font.openFromFile(fontPath))
+    {
+        throw std::runtime_error("Failed to load font: " + fontPath.string());
+    }
+
+    const sf::Vector2u size{static_cast<unsigned int>(replay.width * config.tileSize),
+                            static_cast<unsigned int>(replay.height * config.tileSize)};
+    sf::RenderTexture texture(size);
+
+    sf::Text scoreText(font, "", static_cast<unsigned int>(config.tileSize));
+    scoreText.setFillColor(sf::Color::White);
+    scoreText.setPosition({4.F, 2.F});
+
+    ReplayPlayer player(replay,
+                        replay.map.empty() ? Board(replay.width, replay.height) : loadLevelMap(dataDir / replay.map));
+    BoardRenderer boardRenderer(config.tileSize);
+
+    const unsigned int workers =
+        options.workers > 0 ? options.workers : std::max(1U, std::thread::hardware_concurrency());
+    EncoderPool pool(workers, options.queueLimit);
+
+    ExportStats stats;
+    const char* extension = options.raw ? "rgba" : "png";
+
+    const auto renderFrame = [&]
+    {
+        const Simulation& simulation = player.simulation();
+        texture.clear(sf::Color(18, 18, 18));
+        boardRenderer.draw(texture, simulation);
+        scoreText.setString(std::format("Score: {}", simulation.score()));
+        texture.draw(scoreText);
+        texture.display();
+
+        // Odczyt pikseli na watku renderu, kodowanie w puli.
+        pool.submit({texture.getTexture().copyToImage(),
+                     options.outputDir / std::format("frame_{:06}.{}", player.tick(), extension),
+                     options.raw});
+        ++stats.frames;
+    };
+
+    // Skok do poczatku fragmentu przez klatki kluczowe, potem jedna klatka na tick.
+    player.seek(options.firstTick);
+    const std::uint64_t lastTick = std::min(options.lastTick, player.length());
+    renderFrame();
+
+    while (player.tick() < lastTick)
+    {
+        const bool alive = player.stepForward();
+        renderFrame();
+        if (!alive)
+        {
+            break;
+        }
+    }
+
+    pool.finish();
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return stats;
+}
@@ -1,60 +1,89 @@
 #include "Game.hpp"
 
+#include "AllocationCounter.hpp"
+#include "Input.hpp"
+#include "LevelMap.hpp"
+#include "PerfCounters.hpp"
+#include "Tracer.hpp"
+
 #include <SFML/Window/Event.hpp>
 
 #include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdio>
 #include <filesystem>
+#include <format>
 #include <fstream>
+#include <iterator>
+#include <memory_resource>
 #include <optional>
-#include <sstream>
+#include <print>
 #include <stdexcept>
 #include <string>
+#include <utility>
 
 namespace
 {
 // Ustawienia startowe gry.
-constexpr int initialLength = 3;
-const std::string fontFile = "JetBrainsMono-Regular.ttf";
 const std::string highscoreFile = "highscore.txt";
+const std::string replayFile = "last.replay";
+const std::string checkpointFile = "checkpoint.bin";
+// Co ile sekund gry zapisujemy stan (przerwy w zasilaniu kioskow).
+const sf::Time autosaveInterval = sf::seconds(10.F);
 constexpr std::size_t maxNameLength = 12;
+// Tiki po starcie gry, po ktorych logika nie moze juz alokowac.
+constexpr std::uint64_t warmupTicks = 100;
+// Mnozniki predkosci pod klawiszami 1-4; 0 oznacza tyle tikow, ile zmiesci sie w klatce.
+constexpr std::array<int, 4> speedLevels{1, 10, 100, 0};
+// Czas na tiki w jednej klatce, reszta zostaje na render przy 60 FPS.
+const sf::Time frameTickBudget = sf::milliseconds(12);
+// Najdluzsze czekanie na zdarzenie w menu i pauzie, zanim okno zostanie odswiezone.
+const sf::Time idleRedrawInterval = sf::seconds(1.F);
+
+// Okno na cala plansze, ale nie wieksze niz 90% pulpitu (mapy do 4096x4096 pol).
+sf::VideoMode windowMode(const Board& board, int tileSize)
+{
+    const sf::Vector2u desktop = sf::VideoMode::getDesktopMode().size;
+    return sf::VideoMode({std::min(static_cast<unsigned int>(board.width() * tileSize), desktop.x * 9 / 10),
+                          std::min(static_cast<unsigned int>(board.height() * tileSize), desktop.y * 9 / 10)});
+}
 
-// Mapowanie klawiszy na kierunek.
-Direction directionFromKey(sf::Keyboard::Key key)
+// Srodek kamery w jednej osi: za glowa weza, ale bez wychodzenia poza plansze.
+float cameraCenter(float head, float view, float board)
 {
-    switch (key)
+    if (board <= view)
     {
-    case sf::Keyboard::Key::Up:
-    case sf::Keyboard::Key::W:
-        return Direction::Up;
-    case sf::Keyboard::Key::Down:
-    case sf::Keyboard::Key::S:
-        return Direction::Down;
-    case sf::Keyboard::Key::Left:
-    case sf::Keyboard::Key::A:
-        return Direction::Left;
-    case sf::Keyboard::Key::Right:
-    case sf::Keyboard::Key::D:
-    default:
-        return Direction::Right;
+        return view / 2.F;
     }
+    return std::clamp(head, view / 2.F, board - view / 2.F);
 }
 
-void centerText(sf::Text& text, const sf::Vector2f& center)
+// Indeks poziomu predkosci dla klawisza 1-4.
+std::optional<std::size_t> speedLevelFromKey(sf::Keyboard::Key key)
 {
-    // Ustawia srodek tekstu w zadanym punkcie.
-    const sf::FloatRect bounds = text.getLocalBounds();
-    text.setOrigin(bounds.position + bounds.size / 2.F);
-    text.setPosition(center);
+    switch (key)
+    {
+    case sf::Keyboard::Key::Num1:
+        return 0;
+    case sf::Keyboard::Key::Num2:
+        return 1;
+    case sf::Keyboard::Key::Num3:
+        return 2;
+    case sf::Keyboard::Key::Num4:
+        return 3;
+    default:
+        return std::nullopt;
+    }
 }
 } // namespace
 
-Game::Game(const Config& config, const std::filesystem::path& dataDir)
+Game::Game(const Config& config, const std::filesystem::path& dataDir, const std::optional<BotOptions>& bot)
     : config_(config),
       dataDir_(dataDir),
-      board_(config.width, config.height),
-      snake_({std::clamp(config.width / 2, initialLength - 1, config.width - 1),
-              config.height / 2},
-             initialLength, Direction::Right),
+      simulation_(makeBoard(config, dataDir), Random::makeSeed(), {config.foodCount, config.powerUps}),
+      checkpoints_(dataDir / checkpointFile),
       scoreText_(font_, "", static_cast<unsigned int>(config.tileSize)),
       pauseText_(font_, "", static_cast<unsigned int>(config.tileSize + 6)),
       promptText_(font_, "", static_cast<unsigned int>(config.tileSize + 6)),
@@ -62,21 +91,13 @@ Game::Game(const Config& config, const std::filesystem::path& dataDir)
       gameOverText_(font_, "", static_cast<unsigned int>(config.tileSize * 2)),
       instructionText_(font_, "", static_cast<unsigned int>(config.tileSize)),
       scoreboardText_(font_, "", static_cast<unsigned int>(config.tileSize)),
-      window_(sf::VideoMode(
-                  {static_cast<unsigned int>(config.width * config.tileSize),
-                   static_cast<unsigned int>(config.height * config.tileSize)}),
-              "Snake")
+      window_(windowMode(simulation_.board(), config.tileSize), "Snake"),
+      boardRenderer_(config.tileSize)
 {
     window_.setFramerateLimit(60);
     tickSeconds_ = static_cast<float>(config_.tickMs) / 1000.F;
 
-    snakeShape_.setSize(sf::Vector2f(static_cast<float>(config_.tileSize),
-                                     static_cast<float>(config_.tileSize)));
-    snakeShape_.setFillColor(sf::Color(30, 160, 60));
-
-    foodShape_.setSize(sf::Vector2f(static_cast<float>(config_.tileSize),
-                                    static_cast<float>(config_.tileSize)));
-    foodShape_.setFillColor(sf::Color(220, 80, 60));
+    recorder_.start(simulation_, config_.map.generic_string());
 
     const auto fontPath = dataDir_ / fontFile;
     if (!font_.openFromFile(fontPath))
@@ -95,7 +116,19 @@ Game::Game(const Config& config, const std::filesystem::path& dataDir)
     scoreboardText_.setFillColor(sf::Color::White);
 
     loadHighscores();
-    spawnFood();
+    if (bot)
+    {
+        // Bot gra od razu, bez ekranu nicku i bez wznawiania zapisu gracza.
+        bot_.emplace(*bot);
+        playerName_ = "BOT";
+        nameInput_ = playerName_;
+        state_ = State::Running;
+        bot_->startGame(simulation_);
+    }
+    else
+    {
+        resumeCheckpoint();
+    }
     updateTexts();
 }
 
@@ -105,81 +138,150 @@ void Game::run()
 
     while (window_.isOpen())
     {
-        handleEvents();
+        const TraceScope frameScope("frame");
+
+        // Poza rozgrywka obraz zmienia sie tylko po zdarzeniu, wiec czekamy zamiast rysowac 60 razy na sekunde.
+        if (isIdle())
+        {
+            waitForEvent();
+            // Czas czekania nie jest czasem gry; bez tego start po pauzie nadrabialby zalegle tiki.
+            clock.restart();
+        }
+        else
+        {
+            handleEvents();
+        }
+
         const float dt = clock.restart().asSeconds();
         update(dt);
-        render();
+        if (state_ == State::Running || redraw_)
+        {
+            render();
+        }
+    }
+
+    // Przerwana gra zostaje do wznowienia przy nastepnym starcie.
+    if (state_ == State::Running || state_ == State::Paused)
+    {
+        writeCheckpoint();
     }
+
+    if (bot_)
+    {
+        bot_->report();
+    }
+}
+
+bool Game::isIdle() const
+{
+    // Bot po koncu gry od razu zaczyna nastepna, wiec nie czeka na zdarzenia.
+    return state_ != State::Running && !(bot_ && state_ == State::GameOver);
 }
 
 void Game::handleEvents()
 {
     while (const std::optional<sf::Event> event = window_.pollEvent())
     {
-        if (event->is<sf::Event::Closed>())
+        handleEvent(*event);
+    }
+}
+
+void Game::waitForEvent()
+{
+    // Bez zdarzenia przez dluzszy czas i tak odswiezamy okno (np. po odsloniecu).
+    if (const std::optional<sf::Event> event = window_.waitEvent(idleRedrawInterval))
+    {
+        handleEvent(*event);
+        handleEvents();
+    }
+    else
+    {
+        redraw_ = true;
+    }
+}
+
+void Game::handleEvent(const sf::Event& event)
+{
+    if (event.is<sf::Event::Closed>())
+    {
+        window_.close();
+    }
+    else if (event.is<sf::Event::Resized>() || event.is<sf::Event::FocusGained>())
+    {
+        // Zawartosc okna mogla przepasc.
+        redraw_ = true;
+    }
+    else if (state_ == State::EnterName)
+    {
+        // W tym stanie obslugujemy wpisywanie nicku.
+        if (const auto* text = event.getIf<sf::Event::TextEntered>())
         {
-            window_.close();
+            updateNameInput(text->unicode);
+            updateTexts();
         }
-        else if (state_ == State::EnterName)
+        else if (const auto* key = event.getIf<sf::Event::KeyPressed>())
         {
-            // W tym stanie obslugujemy wpisywanie nicku.
-            if (const auto* text = event->getIf<sf::Event::TextEntered>())
+            if (key->code == sf::Keyboard::Key::Escape)
             {
-                updateNameInput(text->unicode);
-                updateTexts();
+                window_.close();
             }
-            else if (const auto* key = event->getIf<sf::Event::KeyPressed>())
+            else if (key->code == sf::Keyboard::Key::Backspace)
             {
-                if (key->code == sf::Keyboard::Key::Escape)
-                {
-                    window_.close();
-                }
-                else if (key->code == sf::Keyboard::Key::Backspace)
-                {
-                    if (!nameInput_.empty())
-                    {
-                        nameInput_.pop_back();
-                        updateTexts();
-                    }
-                }
-                else if (key->code == sf::Keyboard::Key::Enter)
+                if (!nameInput_.empty())
                 {
-                    if (nameInput_.empty())
-                    {
-                        nameInput_ = "PLAYER";
-                    }
-                    playerName_ = nameInput_;
-                    state_ = State::Running;
+                    nameInput_.pop_back();
                     updateTexts();
                 }
             }
-        }
-        else if (const auto* key = event->getIf<sf::Event::KeyPressed>())
-        {
-            if (key->code == sf::Keyboard::Key::Escape)
-            {
-                window_.close();
-            }
-            else if (key->code == sf::Keyboard::Key::P && state_ != State::GameOver)
+            else if (key->code == sf::Keyboard::Key::Enter)
             {
-                state_ = state_ == State::Paused ? State::Running : State::Paused;
-                if (state_ == State::Paused)
+                if (nameInput_.empty())
                 {
-                    accumulator_ = 0.F;
+                    nameInput_ = "PLAYER";
                 }
+                playerName_ = nameInput_;
+                state_ = State::Running;
                 updateTexts();
             }
-            else if (key->code == sf::Keyboard::Key::R)
+        }
+    }
+    else if (const auto* key = event.getIf<sf::Event::KeyPressed>())
+    {
+        if (key->code == sf::Keyboard::Key::Escape)
+        {
+            window_.close();
+        }
+        else if (key->code == sf::Keyboard::Key::P && state_ != State::GameOver)
+        {
+            state_ = state_ == State::Paused ? State::Running : State::Paused;
+            if (state_ == State::Paused)
             {
-                reset();
+                accumulator_ = 0.F;
+                writeCheckpoint();
             }
-            else
+            updateTexts();
+        }
+        else if (key->code == sf::Keyboard::Key::R)
+        {
+            reset();
+        }
+        else if (key->code == sf::Keyboard::Key::H)
+        {
+            showDanger_ = !showDanger_;
+            redraw_ = true;
+        }
+        else if (const auto level = speedLevelFromKey(key->code))
+        {
+            speedLevel_ = *level;
+            accumulator_ = 0.F;
+            updateTexts();
+        }
+        else if (!bot_)
+        {
+            const Direction requested = directionFromKey(key->code);
+            if (!isOpposite(requested))
             {
-                const Direction requested = directionFromKey(key->code);
-                if (!isOpposite(requested))
-                {
-                    pendingDirection_ = requested;
-                }
+                pendingDirection_ = requested;
             }
         }
     }
@@ -187,54 +289,96 @@ void Game::handleEvents()
 
 void Game::update(float dt)
 {
+    // Bot zaczyna kolejna gre od razu po koncu poprzedniej.
+    if (bot_ && state_ == State::GameOver)
+    {
+        reset();
+    }
+
     if (state_ != State::Running)
     {
         return;
     }
 
+    if (autosaveClock_.getElapsedTime() >= autosaveInterval)
+    {
+        writeCheckpoint();
+    }
+
+    // Tryb turbo: czas gry oderwany od zegara, render raz na klatke.
+    const int multiplier = speedLevels[speedLevel_];
+    const bool unlimited = multiplier == 0;
+    const sf::Clock budget;
+
     // Akumulator dla stalych tickow.
-    accumulator_ += dt;
+    accumulator_ += dt * static_cast<float>(std::max(multiplier, 1));
 
-    while (accumulator_ >= tickSeconds_)
+    while (unlimited || accumulator_ >= tickInterval())
     {
+        const float interval = tickInterval();
         processTick();
-        accumulator_ -= tickSeconds_;
+        if (!unlimited)
+        {
+            accumulator_ -= interval;
+        }
 
         if (state_ != State::Running)
         {
             break;
         }
+
+        // Zaleglosci ponad budzet klatki odrzucamy, zeby okno nie przestalo odpowiadac.
+        if (budget.getElapsedTime() >= frameTickBudget)
+        {
+            accumulator_ = 0.F;
+            break;
+        }
     }
 }
 
 void Game::processTick()
 {
-    snake_.setDirection(pendingDirection_);
-    const GridPos nextHead = snake_.nextHeadPosition();
+    const TraceScope traceScope("processTick");
 
-    // Kolizja ze sciana.
-    if (!board_.inside(nextHead))
+    // Czekanie na odpowiedz bota nie wchodzi do profilu tiku.
+    if (bot_)
     {
-        state_ = State::GameOver;
-        updateTexts();
-        return;
+        const std::optional<Direction> move = bot_->nextMove(pendingDirection_);
+        if (!move)
+        {
+            // Bot sie rozlaczyl: konczymy sesje.
+            state_ = State::Paused;
+            window_.close();
+            return;
+        }
+        if (!isOpposite(*move))
+        {
+            pendingDirection_ = *move;
+        }
     }
 
-    const bool grow = nextHead == food_.position();
-    snake_.move(grow);
+    const PerfScope perfScope(PerfPhase::Tick);
+    [[maybe_unused]] const std::uint64_t allocationsBefore = threadAllocationCount();
 
-    // Kolizja z wlasnym cialem.
-    if (snake_.selfCollision())
+    const StepResult result = simulation_.step(pendingDirection_);
+    dangerStale_ = true;
+    recorder_.record(pendingDirection_, simulation_);
+    if (bot_)
     {
-        state_ = State::GameOver;
-        updateTexts();
-        return;
+        bot_->recordTick(simulation_, result);
     }
 
-    if (grow)
+    // Po rozgrzewce tik logiki nie moze alokowac (liczone z SNAKE_COUNT_ALLOCATIONS).
+    // Wyjatkiem sa okresowe klatki kluczowe powtorki. Sprawdzenie obejmuje tylko logike:
+    // ponizsza aktualizacja napisow (sf::Text::setString) alokuje w SFML i jest poza nim.
+    assert(simulation_.tick() <= warmupTicks || recorder_.allocatedLastTick() ||
+           threadAllocationCount() == allocationsBefore);
+
+    // Kolizja ze sciana lub z wlasnym cialem.
+    if (result == StepResult::HitWall || result == StepResult::HitSelf)
     {
-        ++score_;
-        spawnFood();
+        endGame();
+        return;
     }
 
     if (state_ == State::Running)
@@ -243,26 +387,35 @@ void Game::processTick()
     }
 }
 
+float Game::tickInterval() const
+{
+    return simulation_.speedBoost() ? tickSeconds_ / 2.F : tickSeconds_;
+}
+
 void Game::render()
 {
+    const TraceScope traceScope("render");
+
+    const PerfScope perfScope(PerfPhase::Render);
     window_.clear(sf::Color(18, 18, 18));
 
     if (state_ != State::EnterName)
     {
         // Rysujemy plansze tylko po wpisaniu nicku.
-        for (const auto& segment : snake_.body())
+        window_.setView(boardView());
+        boardRenderer_.draw(window_, simulation_);
+        if (showDanger_ && state_ != State::GameOver)
         {
-            snakeShape_.setPosition(
-                {static_cast<float>(segment.x * config_.tileSize),
-                 static_cast<float>(segment.y * config_.tileSize)});
-            window_.draw(snakeShape_);
+            // Analiza raz na tik, a nie w kazdej klatce (wyniki zostaja w buforach analizatora).
+            if (dangerStale_)
+            {
+                dangerReport_ = &spaceAnalyzer_.analyze(simulation_);
+                dangerChokePoints_ = spaceAnalyzer_.chokePoints(simulation_);
+                dangerStale_ = false;
+            }
+            boardRenderer_.drawDanger(window_, simulation_, *dangerReport_, dangerChokePoints_);
         }
-
-        foodShape_.setPosition(
-            {static_cast<float>(food_.position().x * config_.tileSize),
-             static_cast<float>(food_.position().y * config_.tileSize)});
-        window_.draw(foodShape_);
-
+        window_.setView(window_.getDefaultView());
         window_.draw(scoreText_);
     }
 
@@ -284,24 +437,102 @@ void Game::render()
     }
 
     window_.display();
+    redraw_ = false;
+}
+
+sf::View Game::boardView() const
+{
+    const sf::Vector2f viewSize = window_.getDefaultView().getSize();
+    const auto tile = static_cast<float>(config_.tileSize);
+    const Board& board = simulation_.board();
+    const GridPos head = board.position(simulation_.snake().head());
+
+    const sf::Vector2f center{
+        cameraCenter((static_cast<float>(head.x) + 0.5F) * tile, viewSize.x, static_cast<float>(board.width()) * tile),
+        cameraCenter((static_cast<float>(head.y) + 0.5F) * tile, viewSize.y, static_cast<float>(board.height()) * tile)};
+    return sf::View(center, viewSize);
 }
 
 void Game::reset()
 {
-    const int startX = std::clamp(board_.width() / 2, initialLength - 1, board_.width() - 1);
-    snake_.reset({startX, board_.height() / 2}, initialLength, Direction::Right);
+    simulation_.reset(Random::makeSeed());
+    recorder_.start(simulation_, config_.map.generic_string());
+    dangerStale_ = true;
     pendingDirection_ = Direction::Right;
-    score_ = 0;
     accumulator_ = 0.F;
     state_ = State::Running;
     highscoreRecorded_ = false;
-    spawnFood();
+    if (bot_)
+    {
+        bot_->startGame(simulation_);
+    }
     updateTexts();
 }
 
-void Game::spawnFood()
+void Game::endGame()
 {
-    food_.respawn(board_, snake_, random_);
+    state_ = State::GameOver;
+    // Gry bota nie nadpisuja powtorki, zapisu ani tabeli wynikow gracza.
+    if (!bot_)
+    {
+        saveLastReplay();
+        // Skonczonej gry nie wznawiamy.
+        checkpoints_.discard();
+    }
+    updateTexts();
+}
+
+void Game::writeCheckpoint()
+{
+    const TraceScope traceScope("writeCheckpoint");
+
+    if (bot_)
+    {
+        return;
+    }
+
+    const SessionState session{pendingDirection_, playerName_};
+    checkpoints_.save(session, simulation_, recorder_.replay());
+    autosaveClock_.restart();
+}
+
+void Game::resumeCheckpoint()
+{
+    const auto& path = checkpoints_.path();
+    if (!std::filesystem::exists(path))
+    {
+        return;
+    }
+
+    dangerStale_ = true;
+    try
+    {
+        LoadedCheckpoint loaded = loadCheckpoint(path, simulation_, config_.map.generic_string());
+        checkpoints_.resumed(loaded.replay);
+        recorder_.restore(std::move(loaded.replay));
+        pendingDirection_ = loaded.session.pendingDirection;
+        playerName_ = std::move(loaded.session.playerName);
+        nameInput_ = playerName_;
+
+        // Wznowiona gra czeka na gracza w pauzie.
+        state_ = State::Paused;
+    }
+    catch (const std::exception& ex)
+    {
+        // Uszkodzony lub niepasujacy zapis nie blokuje startu gry.
+        std::println(stderr, "Ignoring checkpoint: {}", ex.what());
+        simulation_.reset(Random::makeSeed());
+        recorder_.start(simulation_, config_.map.generic_string());
+        checkpoints_.discard();
+    }
+}
+
+void Game::saveLastReplay()
+{
+    const TraceScope traceScope("saveReplay");
+
+    // Ostatnia gra do pozniejszego eksportu klatek.
+    saveReplay(recorder_.replay(), dataDir_ / replayFile);
 }
 
 void Game::loadHighscores()
@@ -333,7 +564,7 @@ void Game::loadHighscores()
                 ch = static_cast<char>(ch - ('a' - 'A'));
             }
         }
-        highscores_.push_back({name, score});
+        highscores_.push_back({std::move(name), score});
     }
 
     normalizeHighscores(3);
@@ -341,6 +572,8 @@ void Game::loadHighscores()
 
 void Game::saveHighscores()
 {
+    const TraceScope traceScope("saveHighscores");
+
     const auto path = dataDir_ / highscoreFile;
     std::ofstream output(path, std::ios::trunc);
 
@@ -357,16 +590,19 @@ void Game::saveHighscores()
 
 bool Game::isOpposite(Direction next) const
 {
-    const Direction current = snake_.direction();
-
-    return (current == Direction::Up && next == Direction::Down) ||
-           (current == Direction::Down && next == Direction::Up) ||
-           (current == Direction::Left && next == Direction::Right) ||
-           (current == Direction::Right && next == Direction::Left);
+    return areOpposite(simulation_.snake().direction(), next);
 }
 
 void Game::updateTexts()
 {
+    const TraceScope traceScope("updateTexts");
+
+    redraw_ = true;
+
+    // Arena na czas jednej aktualizacji napisow, bez alokacji na stercie.
+    std::array<std::byte, 1024> frameBuffer;
+    std::pmr::monotonic_buffer_resource frameArena(frameBuffer.data(), frameBuffer.size());
+
     const sf::Vector2f viewSize = window_.getView().getSize();
     const sf::Vector2f center{viewSize.x / 2.F, viewSize.y / 2.F};
 
@@ -389,7 +625,7 @@ void Game::updateTexts()
     }
     else if (state_ == State::GameOver)
     {
-        if (!highscoreRecorded_)
+        if (!highscoreRecorded_ && !bot_)
         {
             updateHighscores();
             highscoreRecorded_ = true;
@@ -399,35 +635,61 @@ void Game::updateTexts()
         gameOverText_.setString("GAME OVER");
         instructionText_.setString("Press R to restart or ESC to quit");
 
-        std::ostringstream boardStream;
-        boardStream << "SCOREBOARD:\n";
+        std::pmr::string boardText("SCOREBOARD:\n", &frameArena);
         if (highscores_.empty())
         {
-            boardStream << "NONE";
+            boardText += "NONE";
         }
         else
         {
             const std::size_t count = std::min<std::size_t>(3, highscores_.size());
             for (std::size_t i = 0; i < count; ++i)
             {
-                boardStream << highscores_[i].name << " " << highscores_[i].score;
+                std::format_to(std::back_inserter(boardText), "{} {}", highscores_[i].name, highscores_[i].score);
                 if (i + 1 < count)
                 {
-                    boardStream << "\n";
+                    boardText += "\n";
                 }
             }
         }
-        scoreboardText_.setString(boardStream.str());
+        scoreboardText_.setString(boardText.c_str());
 
         centerText(gameOverText_, {center.x, viewSize.y * 0.25F});
         centerText(instructionText_, {center.x, viewSize.y * 0.38F});
         centerText(scoreboardText_, {center.x, viewSize.y * 0.62F});
     }
 
+    // Napis wyniku zmieniamy tylko gdy zmienily sie liczby.
     const int bestScore = highscores_.empty() ? 0 : highscores_.front().score;
-    std::ostringstream scoreStream;
-    scoreStream << "Score: " << score_ << "  Best: " << bestScore;
-    scoreText_.setString(scoreStream.str());
+    const std::pair<bool, bool> effects{simulation_.speedBoost(), simulation_.ghost()};
+    if (simulation_.score() != shownScore_ || bestScore != shownBest_ || speedLevel_ != shownSpeedLevel_ ||
+        effects != shownEffects_)
+    {
+        shownScore_ = simulation_.score();
+        shownBest_ = bestScore;
+        shownSpeedLevel_ = speedLevel_;
+        shownEffects_ = effects;
+
+        std::pmr::string scoreLine(&frameArena);
+        std::format_to(std::back_inserter(scoreLine), "Score: {}  Best: {}", shownScore_, shownBest_);
+        if (const int multiplier = speedLevels[speedLevel_]; multiplier == 0)
+        {
+            scoreLine += "  Speed: MAX";
+        }
+        else if (multiplier > 1)
+        {
+            std::format_to(std::back_inserter(scoreLine), "  Speed: {}x", multiplier);
+        }
+        if (effects.first)
+        {
+            scoreLine += "  FAST";
+        }
+        if (effects.second)
+        {
+            scoreLine += "  GHOST";
+        }
+        scoreText_.setString(scoreLine.c_str());
+    }
 }
 
 void Game::updateNameInput(char32_t unicode)
@@ -468,11 +730,11 @@ void Game::updateHighscores()
 
     if (existing == highscores_.end())
     {
-        highscores_.push_back({playerName_, score_});
+        highscores_.push_back({playerName_, simulation_.score()});
     }
-    else if (score_ > existing->score)
+    else if (simulation_.score() > existing->score)
     {
-        existing->score = score_;
+        existing->score = simulation_.score();
     }
 
     normalizeHighscores(3);
@@ -484,14 +746,14 @@ void Game::normalizeHighscores(std::size_t limit)
     // Laczne wyniki dla tego samego nicku.
     std::vector<HighscoreEntry> merged;
 
-    for (const auto& entry : highscores_)
+    for (auto& entry : highscores_)
     {
         auto existing = std::find_if(merged.begin(), merged.end(),
                                      [&](const HighscoreEntry& other)
                                      { return other.name == entry.name; });
         if (existing == merged.end())
         {
-            merged.push_back(entry);
+            merged.push_back(std::move(entry));
         }
         else if (entry.score > existing->score)
         {
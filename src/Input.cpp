@@ -0,0 +1,28 @@
+#include "Input.hpp"
+
+Direction directionFromKey(sf::Keyboard::Key key)
+{
+    switch (key)
+    {
+    case sf::Keyboard::Key::Up:
+    case sf::Keyboard::Key::W:
+        return Direction::Up;
+    case sf::Keyboard::Key::Down:
+    case sf::Keyboard::Key::S:
+        return Direction::Down;
+    case sf::Keyboard::Key::Left:
+    case sf::Keyboard::Key::A:
+        return Direction::Left;
+    case sf::Keyboard::Key::Right:
+    case sf::Keyboard::Key::D:
+    default:
+        return Direction::Right;
+    }
+}
+
+void centerText(sf::Text& text, const sf::Vector2f& center)
+{
+    const sf::FloatRect bounds = text.getLocalBounds();
+    text.setOrigin(bounds.position + bounds.size / 2.F);
+    text.setPosition(center);
+}
@@ -0,0 +1,94 @@
+#include "LevelMap.hpp"
+
+#include "MappedFile.hpp"
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+// Dzieli tekst mapy na wiersze bez kopiowania (obcina '\r' z konca).
+std::vector<std::string_view> splitRows(std::string_view text)
+{
+    std::vector<std::string_view> rows;
+    std::size_t start = 0;
+
+    while (start < text.size())
+    {
+        std::size_t end = text.find('\n', start);
+        if (end == std::string_view::npos)
+        {
+            end = text.size();
+        }
+
+        std::string_view row = text.substr(start, end - start);
+        if (!row.empty() && row.back() == '\r')
+        {
+            row.remove_suffix(1);
+        }
+        rows.push_back(row);
+        start = end + 1;
+    }
+
+    // Pusty ostatni wiersz po koncowym znaku nowej linii nie jest czescia mapy.
+    while (!rows.empty() && rows.back().empty())
+    {
+        rows.pop_back();
+    }
+
+    return rows;
+}
+} // namespace
+
+Board loadLevelMap(const std::filesystem::path& path)
+{
+    const MappedFile file(path);
+    const std::vector<std::string_view> rows = splitRows(file.data());
+
+    const int height = static_cast<int>(rows.size());
+    const int width = rows.empty() ? 0 : static_cast<int>(rows.front().size());
+
+    if (width < 3 || height < 3 || width > maxMapSize || height > maxMapSize)
+    {
+        throw std::invalid_argument("Map size must be between 3x3 and 4096x4096: " + path.string());
+    }
+
+    Board board(width, height);
+
+    for (int y = 0; y < height; ++y)
+    {
+        const std::string_view row = rows[static_cast<std::size_t>(y)];
+        if (static_cast<int>(row.size()) != width)
+        {
+            throw std::invalid_argument("Map rows must have equal length (row " + std::to_string(y + 1) + ")");
+        }
+
+        for (int x = 0; x < width; ++x)
+        {
+            const char tile = row[static_cast<std::size_t>(x)];
+            if (tile == '#')
+            {
+                board.setWall({x, y});
+            }
+            else if (tile != '.' && tile != ' ')
+            {
+                throw std::invalid_argument("Invalid map tile '" + std::string(1, tile) + "' in " + path.string());
+            }
+        }
+    }
+
+    return board;
+}
+
+Board makeBoard(const Config& config, const std::filesystem::path& dataDir)
+{
+    if (config.map.empty())
+    {
+        return Board(config.width, config.height);
+    }
+
+    return loadLevelMap(dataDir / config.map);
+}
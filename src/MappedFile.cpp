@@ -0,0 +1,70 @@
+#include "MappedFile.hpp"
+
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define SNAKE_HAS_MMAP 1
+#endif
+
+MappedFile::MappedFile(const std::filesystem::path& path)
+{
+#ifdef SNAKE_HAS_MMAP
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd == -1)
+    {
+        throw std::runtime_error("Failed to open file: " + path.string());
+    }
+
+    struct stat info{};
+    if (fstat(fd, &info) == -1)
+    {
+        close(fd);
+        throw std::runtime_error("Failed to stat file: " + path.string());
+    }
+
+    size_ = static_cast<std::size_t>(info.st_size);
+    if (size_ > 0)
+    {
+        void* mapped = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapped == MAP_FAILED)
+        {
+            close(fd);
+            throw std::runtime_error("Failed to map file: " + path.string());
+        }
+        // Plik czytamy raz od poczatku do konca.
+        madvise(mapped, size_, MADV_SEQUENTIAL);
+        data_ = static_cast<const char*>(mapped);
+    }
+    close(fd);
+#else
+    std::ifstream input(path, std::ios::binary);
+    if (!input)
+    {
+        throw std::runtime_error("Failed to open file: " + path.string());
+    }
+    fallback_.assign(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+    data_ = fallback_.data();
+    size_ = fallback_.size();
+#endif
+}
+
+MappedFile::~MappedFile()
+{
+#ifdef SNAKE_HAS_MMAP
+    if (data_ != nullptr)
+    {
+        munmap(const_cast<char*>(data_), size_);
+    }
+#endif
+}
+
+std::string_view MappedFile::data() const
+{
+    return {data_, size_};
+}
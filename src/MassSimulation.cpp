@@ -0,0 +1,225 @@
+#include "MassSimulation.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <format>
+#include <memory>
+#include <new>
+#include <print>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace
+{
+// Tyle gier watek bierze naraz ze wspolnego licznika.
+constexpr std::uint64_t gamesPerClaim = 64;
+const auto progressInterval = std::chrono::seconds(1);
+
+// Statystyki watku w osobnej linii pamieci podrecznej (bez falszywego wspoldzielenia).
+struct alignas(64) WorkerSlot
+{
+    GameStats stats;
+};
+
+std::size_t causeIndex(DeathCause cause)
+{
+    return static_cast<std::size_t>(cause);
+}
+
+void playGames(const Board& board,
+               const MassOptions& options,
+               std::uint64_t maxTicks,
+               std::atomic<std::uint64_t>& nextGame,
+               std::atomic<std::uint64_t>& finished,
+               GameStats& stats)
+{
+    Simulation simulation(board, options.seed, options.items);
+    PolicyState policyState;
+
+    while (true)
+    {
+        const std::uint64_t first = nextGame.fetch_add(gamesPerClaim, std::memory_order_relaxed);
+        if (first >= options.games)
+        {
+            return;
+        }
+        const std::uint64_t last = std::min(first + gamesPerClaim, options.games);
+
+        for (std::uint64_t game = first; game < last; ++game)
+        {
+            const auto seed = static_cast<std::uint32_t>(options.seed + game);
+            const GameOutcome outcome =
+                playPolicyGame(simulation, options.policy, policyState, seed, maxTicks, &stats.ticksPerFood);
+            stats.recordGame(outcome.score, outcome.ticks, outcome.cause);
+        }
+
+        finished.fetch_add(last - first, std::memory_order_relaxed);
+    }
+}
+
+void writeSketchJson(std::ostream& output, std::string_view name, const QuantileSketch& sketch)
+{
+    output << std::format("  \"{}\": {{\"count\": {}, \"mean\": {:.3f}, \"min\": {:.0f}, \"p50\": {:.1f}, "
+                          "\"p90\": {:.1f}, \"p99\": {:.1f}, \"max\": {:.0f}}},\n",
+                          name,
+                          sketch.count(),
+                          sketch.mean(),
+                          sketch.min(),
+                          sketch.quantile(0.50),
+                          sketch.quantile(0.90),
+                          sketch.quantile(0.99),
+                          sketch.max());
+}
+} // namespace
+
+GameOutcome playPolicyGame(Simulation& simulation,
+                           Policy policy,
+                           PolicyState& state,
+                           std::uint32_t seed,
+                           std::uint64_t maxTicks,
+                           QuantileSketch* ticksPerFood)
+{
+    simulation.reset(seed);
+    // Strategia losuje z osobnego generatora, zeby nie zmieniac jedzenia.
+    state.random.reseed(~seed);
+
+    std::uint64_t lastFood = 0;
+    DeathCause cause = DeathCause::Timeout;
+    while (simulation.tick() < maxTicks)
+    {
+        const StepResult result = simulation.step(choosePolicyMove(policy, simulation, state));
+        if (result == StepResult::Ate)
+        {
+            if (ticksPerFood != nullptr)
+            {
+                ticksPerFood->add(static_cast<double>(simulation.tick() - lastFood));
+            }
+            lastFood = simulation.tick();
+        }
+        else if (result == StepResult::HitWall || result == StepResult::HitSelf)
+        {
+            cause = result == StepResult::HitWall ? DeathCause::Wall : DeathCause::Self;
+            break;
+        }
+    }
+
+    return {simulation.score(), simulation.tick(), cause};
+}
+
+std::uint64_t resolveMaxTicks(const Board& board, std::uint64_t requested)
+{
+    return requested != 0 ? requested : 100 * board.passableCount();
+}
+
+void GameStats::recordGame(int score, std::uint64_t ticks, DeathCause cause)
+{
+    ++games;
+    ++deaths[causeIndex(cause)];
+
+    const auto index = static_cast<std::size_t>(std::max(score, 0));
+    if (index >= scoreHistogram.size())
+    {
+        scoreHistogram.resize(index + 1);
+    }
+    ++scoreHistogram[index];
+
+    scores.add(score);
+    lengths.add(static_cast<double>(ticks));
+}
+
+void GameStats::merge(const GameStats& other)
+{
+    games += other.games;
+    for (std::size_t i = 0; i < deaths.size(); ++i)
+    {
+        deaths[i] += other.deaths[i];
+    }
+
+    if (other.scoreHistogram.size() > scoreHistogram.size())
+    {
+        scoreHistogram.resize(other.scoreHistogram.size());
+    }
+    for (std::size_t i = 0; i < other.scoreHistogram.size(); ++i)
+    {
+        scoreHistogram[i] += other.scoreHistogram[i];
+    }
+
+    scores.merge(other.scores);
+    lengths.merge(other.lengths);
+    ticksPerFood.merge(other.ticksPerFood);
+}
+
+MassResult runMassSimulation(const Board& board, const MassOptions& options)
+{
+    MassResult result;
+    result.threads = options.threads != 0 ? options.threads : std::max(1U, std::thread::hardware_concurrency());
+    const std::uint64_t maxTicks = resolveMaxTicks(board, options.maxTicks);
+
+    std::atomic<std::uint64_t> nextGame{0};
+    std::atomic<std::uint64_t> finished{0};
+    const auto slots = std::make_unique<WorkerSlot[]>(result.threads);
+    const auto started = std::chrono::steady_clock::now();
+
+    {
+        std::vector<std::jthread> workers;
+        for (unsigned int i = 0; i < result.threads; ++i)
+        {
+            workers.emplace_back(
+                [&, i] { playGames(board, options, maxTicks, nextGame, finished, slots[i].stats); });
+        }
+
+        // Postep czytamy z licznika atomowego, bez zagladania do statystyk watkow.
+        auto nextReport = started + progressInterval;
+        while (finished.load(std::memory_order_relaxed) < options.games)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            if (std::chrono::steady_clock::now() >= nextReport)
+            {
+                std::println(stderr, "{} / {} games", finished.load(std::memory_order_relaxed), options.games);
+                nextReport += progressInterval;
+            }
+        }
+    }
+
+    // Po zakonczeniu watkow kazdy slot ma jednego czytelnika, wiec laczenie nie potrzebuje blokad.
+    for (unsigned int i = 0; i < result.threads; ++i)
+    {
+        result.stats.merge(slots[i].stats);
+    }
+
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    return result;
+}
+
+void writeStatsJson(std::ostream& output, const MassResult& result, const MassOptions& options)
+{
+    const GameStats& stats = result.stats;
+
+    output << "{\n";
+    output << std::format("  \"games\": {},\n  \"threads\": {},\n  \"policy\": \"{}\",\n  \"seed\": {},\n",
+                          stats.games,
+                          result.threads,
+                          policyName(options.policy),
+                          options.seed);
+    output << std::format("  \"seconds\": {:.3f},\n  \"gamesPerSecond\": {:.1f},\n",
+                          result.seconds,
+                          result.seconds > 0.0 ? static_cast<double>(stats.games) / result.seconds : 0.0);
+    output << std::format("  \"deaths\": {{\"wall\": {}, \"self\": {}, \"timeout\": {}}},\n",
+                          stats.deaths[causeIndex(DeathCause::Wall)],
+                          stats.deaths[causeIndex(DeathCause::Self)],
+                          stats.deaths[causeIndex(DeathCause::Timeout)]);
+
+    writeSketchJson(output, "score", stats.scores);
+    writeSketchJson(output, "gameLength", stats.lengths);
+    writeSketchJson(output, "ticksPerFood", stats.ticksPerFood);
+
+    output << "  \"scoreHistogram\": [";
+    for (std::size_t i = 0; i < stats.scoreHistogram.size(); ++i)
+    {
+        output << (i == 0 ? "" : ", ") << stats.scoreHistogram[i];
+    }
+    output << "]\n}\n";
+}
@@ -0,0 +1,210 @@
+#include "PerfCounters.hpp"
+
+#include <format>
+#include <stdexcept>
+#include <string_view>
+
+#if defined(SNAKE_PERF_COUNTERS) && defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define SNAKE_HAS_PERF 1
+#endif
+
+namespace
+{
+constexpr std::array<std::string_view, 3> phaseNames{"tick", "respawn", "render"};
+
+#ifdef SNAKE_HAS_PERF
+// Kolejnosc zgodna z polami Reading.
+constexpr std::array<std::uint64_t, 4> hardwareEvents{PERF_COUNT_HW_CPU_CYCLES,
+                                                      PERF_COUNT_HW_INSTRUCTIONS,
+                                                      PERF_COUNT_HW_CACHE_MISSES,
+                                                      PERF_COUNT_HW_BRANCH_MISSES};
+
+int openCounter(std::uint64_t config, int groupFd)
+{
+    perf_event_attr attr{};
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = config;
+    attr.disabled = groupFd == -1 ? 1 : 0;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP;
+
+    // Biezacy watek, dowolny procesor.
+    return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, groupFd, 0));
+}
+#endif
+
+double perCall(std::uint64_t value, std::uint64_t calls)
+{
+    return calls == 0 ? 0.0 : static_cast<double>(value) / static_cast<double>(calls);
+}
+} // namespace
+
+PerfCounters& PerfCounters::instance()
+{
+    static PerfCounters counters;
+    return counters;
+}
+
+PerfCounters::~PerfCounters()
+{
+    flush();
+#ifdef SNAKE_HAS_PERF
+    for (const int fd : fds_)
+    {
+        if (fd != -1)
+        {
+            close(fd);
+        }
+    }
+#endif
+}
+
+void PerfCounters::enable(const std::filesystem::path& reportPath)
+{
+#ifdef SNAKE_HAS_PERF
+    for (std::size_t i = 0; i < counterCount; ++i)
+    {
+        fds_[i] = openCounter(hardwareEvents[i], i == 0 ? -1 : fds_[0]);
+        if (fds_[i] == -1)
+        {
+            throw std::runtime_error("perf_event_open failed (check kernel.perf_event_paranoid)");
+        }
+    }
+
+    report_.open(reportPath, std::ios::trunc);
+    if (!report_)
+    {
+        throw std::runtime_error("Failed to write perf report: " + reportPath.string());
+    }
+
+    ioctl(fds_[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(fds_[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    owner_ = std::this_thread::get_id();
+    enabled_ = true;
+#else
+    throw std::runtime_error("Performance counters are not available in this build: " + reportPath.string());
+#endif
+}
+
+bool PerfCounters::enabled() const
+{
+    return enabled_;
+}
+
+void PerfCounters::begin(PerfPhase phase)
+{
+    read(started_[static_cast<std::size_t>(phase)]);
+}
+
+void PerfCounters::end(PerfPhase phase)
+{
+    Reading now{};
+    if (!read(now))
+    {
+        return;
+    }
+
+    const auto index = static_cast<std::size_t>(phase);
+    Totals& totals = window_[index];
+    ++totals.calls;
+    for (std::size_t i = 0; i < counterCount; ++i)
+    {
+        totals.counters[i] += now[i] - started_[index][i];
+    }
+
+    if (phase == PerfPhase::Tick && ++ticks_ - windowStart_ == windowTicks)
+    {
+        writeWindow();
+    }
+}
+
+void PerfCounters::flush()
+{
+    if (enabled_ && ticks_ > windowStart_)
+    {
+        writeWindow();
+    }
+    report_.flush();
+}
+
+bool PerfCounters::read(Reading& reading) const
+{
+#ifdef SNAKE_HAS_PERF
+    if (!enabled_ || std::this_thread::get_id() != owner_)
+    {
+        return false;
+    }
+
+    // Format grupy: liczba licznikow, potem wartosci.
+    std::array<std::uint64_t, counterCount + 1> buffer{};
+    if (::read(fds_[0], buffer.data(), sizeof(buffer)) != static_cast<ssize_t>(sizeof(buffer)))
+    {
+        return false;
+    }
+
+    for (std::size_t i = 0; i < counterCount; ++i)
+    {
+        reading[i] = buffer[i + 1];
+    }
+    return true;
+#else
+    (void)reading;
+    return false;
+#endif
+}
+
+void PerfCounters::writeWindow()
+{
+    report_ << std::format("ticks {}-{}\n", windowStart_ + 1, ticks_);
+    report_ << std::format("{:<8} {:>8} {:>12} {:>12} {:>6} {:>12} {:>12}\n",
+                           "phase",
+                           "calls",
+                           "cycles/call",
+                           "instr/call",
+                           "IPC",
+                           "cache-miss",
+                           "branch-miss");
+
+    for (std::size_t i = 0; i < phaseCount; ++i)
+    {
+        const Totals& totals = window_[i];
+        const auto& [cycles, instructions, cacheMisses, branchMisses] = totals.counters;
+        const double ipc = cycles == 0 ? 0.0 : static_cast<double>(instructions) / static_cast<double>(cycles);
+
+        report_ << std::format("{:<8} {:>8} {:>12.0f} {:>12.0f} {:>6.2f} {:>12.1f} {:>12.1f}\n",
+                               phaseNames[i],
+                               totals.calls,
+                               perCall(cycles, totals.calls),
+                               perCall(instructions, totals.calls),
+                               ipc,
+                               perCall(cacheMisses, totals.calls),
+                               perCall(branchMisses, totals.calls));
+    }
+    report_ << "\n";
+
+    window_ = {};
+    windowStart_ = ticks_;
+}
+
+PerfScope::PerfScope(PerfPhase phase)
+    : phase_(phase), active_(PerfCounters::instance().enabled())
+{
+    if (active_)
+    {
+        PerfCounters::instance().begin(phase_);
+    }
+}
+
+PerfScope::~PerfScope()
+{
+    if (active_)
+    {
+        PerfCounters::instance().end(phase_);
+    }
+}
@@ -0,0 +1,176 @@
+#include "Policy.hpp"
+
+#include <array>
+#include <cstdlib>
+#include <span>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+constexpr std::array<Direction, 4> allDirections{Direction::Up, Direction::Down, Direction::Left, Direction::Right};
+
+// Czy ruch nie konczy gry w tym tiku (ogon zwalnia pole, chyba ze waz rosnie).
+bool isSafe(const Simulation& simulation, Direction direction)
+{
+    const Board& board = simulation.board();
+    const Snake& snake = simulation.snake();
+    const Cell next = neighbor(snake.head(), board.step(direction));
+
+    if (!board.passable(next))
+    {
+        return false;
+    }
+    if (!snake.occupies(next))
+    {
+        return true;
+    }
+    return next == snake.body().back() && !simulation.food().hasFood(next);
+}
+
+int distance(const GridPos& a, const GridPos& b)
+{
+    return std::abs(a.x - b.x) + std::abs(a.y - b.y);
+}
+
+// Najblizsze glowie aktywne jedzenie (pierwsze przy remisie); przy pelnej planszy ostatnie polozenie.
+GridPos nearestFood(const Simulation& simulation, const GridPos& head)
+{
+    const Board& board = simulation.board();
+    GridPos best = board.position(simulation.food().position());
+    int bestDistance = -1;
+    for (const Item& item : simulation.food().items())
+    {
+        if (!item.active || item.kind != ItemKind::Food)
+        {
+            continue;
+        }
+        const GridPos candidate = board.position(item.cell);
+        const int candidateDistance = distance(head, candidate);
+        if (bestDistance < 0 || candidateDistance < bestDistance)
+        {
+            best = candidate;
+            bestDistance = candidateDistance;
+        }
+    }
+    return best;
+}
+
+// Ruch z listy najblizszy jedzeniu (pierwszy przy remisie); lista nie moze byc pusta.
+Direction closestToFood(const Simulation& simulation, std::span<const Direction> moves)
+{
+    const Board& board = simulation.board();
+    const GridPos head = board.position(simulation.snake().head());
+    const GridPos food = nearestFood(simulation, head);
+
+    Direction best = moves[0];
+    int bestDistance = distance(head + directionOffset(best), food);
+    for (std::size_t i = 1; i < moves.size(); ++i)
+    {
+        const int candidate = distance(head + directionOffset(moves[i]), food);
+        if (candidate < bestDistance)
+        {
+            best = moves[i];
+            bestDistance = candidate;
+        }
+    }
+    return best;
+}
+
+// Do jedzenia tylko ruchami, po ktorych waz sie miesci albo dojdzie do ogona;
+// bez takiego ruchu wybiera najwiekszy obszar.
+Direction chooseSpaceMove(const Simulation& simulation, SpaceAnalyzer& analyzer)
+{
+    const SpaceReport& report = analyzer.analyze(simulation);
+    const auto length = static_cast<std::uint32_t>(simulation.snake().body().size());
+
+    std::array<Direction, 3> roomy{};
+    std::size_t roomyCount = 0;
+    const MoveSpace* largest = nullptr;
+    for (std::size_t i = 0; i < report.moveCount; ++i)
+    {
+        const MoveSpace& move = report.moves[i];
+        if (!move.safe)
+        {
+            continue;
+        }
+        if (move.tailReachable || move.regionSize > length)
+        {
+            roomy[roomyCount++] = move.direction;
+        }
+        if (largest == nullptr || move.regionSize > largest->regionSize)
+        {
+            largest = &move;
+        }
+    }
+
+    if (roomyCount > 0)
+    {
+        return closestToFood(simulation, std::span<const Direction>(roomy.data(), roomyCount));
+    }
+    return largest != nullptr ? largest->direction : simulation.snake().direction();
+}
+} // namespace
+
+Policy policyFromName(std::string_view name)
+{
+    if (name == "random")
+    {
+        return Policy::Random;
+    }
+    if (name == "greedy")
+    {
+        return Policy::Greedy;
+    }
+    if (name == "space")
+    {
+        return Policy::Space;
+    }
+    throw std::invalid_argument("Unknown policy: " + std::string(name));
+}
+
+std::string_view policyName(Policy policy)
+{
+    switch (policy)
+    {
+    case Policy::Random:
+        return "random";
+    case Policy::Greedy:
+        return "greedy";
+    case Policy::Space:
+        return "space";
+    }
+    return "unknown";
+}
+
+Direction choosePolicyMove(Policy policy, const Simulation& simulation, PolicyState& state)
+{
+    const Direction current = simulation.snake().direction();
+
+    if (policy == Policy::Space)
+    {
+        return chooseSpaceMove(simulation, state.space);
+    }
+
+    std::array<Direction, 3> safe{};
+    std::size_t safeCount = 0;
+    for (const Direction direction : allDirections)
+    {
+        if (!areOpposite(current, direction) && isSafe(simulation, direction))
+        {
+            safe[safeCount++] = direction;
+        }
+    }
+
+    if (safeCount == 0)
+    {
+        return current;
+    }
+
+    if (policy == Policy::Random)
+    {
+        return safe[static_cast<std::size_t>(state.random.uniformInt(0, static_cast<int>(safeCount) - 1))];
+    }
+
+    return closestToFood(simulation, std::span<const Direction>(safe.data(), safeCount));
+}
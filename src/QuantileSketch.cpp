@@ -0,0 +1,123 @@
+#include "QuantileSketch.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+QuantileSketch::QuantileSketch(double relativeError)
+    : relativeError_(relativeError),
+      logGamma_(std::log((1.0 + relativeError) / (1.0 - relativeError)))
+{
+    if (!(relativeError > 0.0 && relativeError < 1.0))
+    {
+        throw std::invalid_argument("Quantile sketch error must be between 0 and 1");
+    }
+}
+
+void QuantileSketch::add(double value)
+{
+    value = std::max(value, 0.0);
+    min_ = count_ == 0 ? value : std::min(min_, value);
+    max_ = count_ == 0 ? value : std::max(max_, value);
+    ++count_;
+    sum_ += value;
+
+    if (value < 1.0)
+    {
+        ++zeroCount_;
+        return;
+    }
+
+    const std::size_t index = bucketIndex(value);
+    if (index >= buckets_.size())
+    {
+        buckets_.resize(index + 1);
+    }
+    ++buckets_[index];
+}
+
+void QuantileSketch::merge(const QuantileSketch& other)
+{
+    if (other.relativeError_ != relativeError_)
+    {
+        throw std::invalid_argument("Cannot merge quantile sketches with different accuracy");
+    }
+    if (other.count_ == 0)
+    {
+        return;
+    }
+
+    min_ = count_ == 0 ? other.min_ : std::min(min_, other.min_);
+    max_ = count_ == 0 ? other.max_ : std::max(max_, other.max_);
+    count_ += other.count_;
+    sum_ += other.sum_;
+    zeroCount_ += other.zeroCount_;
+
+    if (other.buckets_.size() > buckets_.size())
+    {
+        buckets_.resize(other.buckets_.size());
+    }
+    for (std::size_t i = 0; i < other.buckets_.size(); ++i)
+    {
+        buckets_[i] += other.buckets_[i];
+    }
+}
+
+double QuantileSketch::quantile(double q) const
+{
+    if (count_ == 0)
+    {
+        return 0.0;
+    }
+
+    // Pozycja w posortowanych wartosciach.
+    const auto rank = static_cast<std::uint64_t>(std::clamp(q, 0.0, 1.0) * static_cast<double>(count_ - 1));
+    std::uint64_t seen = zeroCount_;
+    if (seen > rank)
+    {
+        return min_;
+    }
+
+    for (std::size_t i = 0; i < buckets_.size(); ++i)
+    {
+        seen += buckets_[i];
+        if (seen > rank)
+        {
+            return std::clamp(bucketValue(i), min_, max_);
+        }
+    }
+    return max_;
+}
+
+std::uint64_t QuantileSketch::count() const
+{
+    return count_;
+}
+
+double QuantileSketch::mean() const
+{
+    return count_ == 0 ? 0.0 : sum_ / static_cast<double>(count_);
+}
+
+double QuantileSketch::min() const
+{
+    return min_;
+}
+
+double QuantileSketch::max() const
+{
+    return max_;
+}
+
+std::size_t QuantileSketch::bucketIndex(double value) const
+{
+    // Przedzial i obejmuje wartosci z (gamma^(i-1), gamma^i].
+    return static_cast<std::size_t>(std::ceil(std::log(value) / logGamma_));
+}
+
+double QuantileSketch::bucketValue(std::size_t index) const
+{
+    // Srodek przedzialu w sensie bledu wzglednego.
+    const double gamma = std::exp(logGamma_);
+    return 2.0 * std::exp(static_cast<double>(index) * logGamma_) / (gamma + 1.0);
+}
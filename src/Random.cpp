@@ -1,17 +1,90 @@
 #include "Random.hpp"
 
+#include "BinaryIO.hpp"
+
+#include <array>
 #include <chrono>
 #include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
 
 Random::Random()
-    : engine_(static_cast<std::mt19937::result_type>(
-          std::chrono::steady_clock::now().time_since_epoch().count()))
+    : Random(makeSeed())
 {
     // Seed z zegara wystarczy do gry.
 }
 
+Random::Random(std::uint32_t seed)
+    : seed_(seed), engine_(seed)
+{
+}
+
 int Random::uniformInt(int min, int max)
 {
     std::uniform_int_distribution<int> dist(min, max);
     return dist(engine_);
 }
+
+void Random::reseed(std::uint32_t seed)
+{
+    seed_ = seed;
+    engine_.seed(seed);
+}
+
+std::uint32_t Random::seed() const
+{
+    return seed_;
+}
+
+std::uint32_t Random::makeSeed()
+{
+    return static_cast<std::uint32_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+}
+
+void Random::writeState(std::vector<std::byte>& output) const
+{
+    // Standard gwarantuje tylko tekstowy zapis silnika; zamieniamy go na liczby binarne.
+    std::ostringstream text;
+    text << engine_;
+
+    std::istringstream numbers(text.str());
+    std::vector<std::uint32_t> words;
+    std::uint64_t word = 0;
+    while (numbers >> word)
+    {
+        words.push_back(static_cast<std::uint32_t>(word));
+    }
+
+    appendValue(output, seed_);
+    appendValue(output, static_cast<std::uint32_t>(words.size()));
+    appendValues(output, std::span<const std::uint32_t>(words));
+}
+
+void Random::readState(ByteReader& input)
+{
+    const auto seed = input.read<std::uint32_t>();
+    // Liczbe slow sprawdzamy przed czytaniem, zeby uszkodzony zapis nie wymusil duzej alokacji.
+    const auto count = input.read<std::uint32_t>();
+    if (count > std::mt19937::state_size + 1 || count > input.remaining() / sizeof(std::uint32_t))
+    {
+        throw std::invalid_argument("Corrupted random engine state");
+    }
+    std::array<std::uint32_t, std::mt19937::state_size + 1> words{};
+    input.readInto(std::span<std::uint32_t>(words.data(), count));
+
+    std::string text;
+    for (const std::uint32_t word : std::span<const std::uint32_t>(words.data(), count))
+    {
+        text += std::to_string(word);
+        text += ' ';
+    }
+
+    std::istringstream stream(text);
+    stream >> engine_;
+    if (!stream)
+    {
+        throw std::invalid_argument("Corrupted random engine state");
+    }
+    seed_ = seed;
+}
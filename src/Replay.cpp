@@ -0,0 +1,158 @@
+#include "Replay.hpp"
+
+#include "BinaryIO.hpp"
+
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+// Naglowek pliku powtorki.
+constexpr std::array<char, 4> replayMagic{'S', 'N', 'K', 'R'};
+constexpr std::uint32_t replayVersion = 4;
+constexpr std::uint32_t maxMapPathLength = 4096;
+
+template <typename T>
+void writeBlock(std::ostream& output, const std::vector<T>& values)
+{
+    output.write(reinterpret_cast<const char*>(values.data()), static_cast<std::streamsize>(values.size() * sizeof(T)));
+}
+
+// Czyta blok, ktorego rozmiar pochodzi z pliku, sprawdzajac go z rozmiarem pliku.
+template <typename T>
+void readBlock(std::istream& input, std::vector<T>& values, std::uint64_t count, std::uintmax_t fileSize)
+{
+    if (!input || count > fileSize / sizeof(T))
+    {
+        throw std::invalid_argument("Corrupted replay block size");
+    }
+    values.resize(count);
+    input.read(reinterpret_cast<char*>(values.data()), static_cast<std::streamsize>(count * sizeof(T)));
+    if (!input)
+    {
+        throw std::invalid_argument("Truncated replay file");
+    }
+}
+} // namespace
+
+void writeReplay(std::ostream& output, const Replay& replay)
+{
+    output.write(replayMagic.data(), replayMagic.size());
+    writeValue(output, replayVersion);
+    writeValue(output, replay.seed);
+    writeValue(output, static_cast<std::int32_t>(replay.width));
+    writeValue(output, static_cast<std::int32_t>(replay.height));
+    writeValue(output, static_cast<std::uint32_t>(replay.map.size()));
+    output.write(replay.map.data(), static_cast<std::streamsize>(replay.map.size()));
+    writeValue(output, static_cast<std::int32_t>(replay.foodCount));
+    writeValue(output, static_cast<std::int32_t>(replay.powerUps));
+
+    // Jeden bajt na tick, zapis jednym blokiem.
+    writeValue(output, static_cast<std::uint64_t>(replay.directions.size()));
+    writeBlock(output, replay.directions);
+
+    // Indeks klatek kluczowych, potem ich dane.
+    writeValue(output, static_cast<std::uint64_t>(replay.keyframes.size()));
+    writeBlock(output, replay.keyframes);
+    writeValue(output, static_cast<std::uint64_t>(replay.keyframeData.size()));
+    writeBlock(output, replay.keyframeData);
+}
+
+Replay readReplay(std::istream& input, std::uintmax_t sizeLimit)
+{
+    std::array<char, 4> magic{};
+    input.read(magic.data(), magic.size());
+    if (!input || magic != replayMagic)
+    {
+        throw std::invalid_argument("Not a replay stream");
+    }
+
+    // Wersja 1 nie miala mapy poziomu, wersja 2 klatek kluczowych, wersja 3 liczby przedmiotow.
+    const auto version = readValue<std::uint32_t>(input);
+    if (version < 1 || version > replayVersion)
+    {
+        throw std::invalid_argument("Unsupported replay version " + std::to_string(version));
+    }
+
+    Replay replay;
+    replay.seed = readValue<std::uint32_t>(input);
+    replay.width = readValue<std::int32_t>(input);
+    replay.height = readValue<std::int32_t>(input);
+    if (version >= 2)
+    {
+        const auto mapLength = readValue<std::uint32_t>(input);
+        if (!input || mapLength > maxMapPathLength)
+        {
+            throw std::invalid_argument("Corrupted replay header");
+        }
+        replay.map.resize(mapLength);
+        input.read(replay.map.data(), static_cast<std::streamsize>(replay.map.size()));
+    }
+    if (version >= 4)
+    {
+        replay.foodCount = readValue<std::int32_t>(input);
+        replay.powerUps = readValue<std::int32_t>(input);
+    }
+
+    if (!input || replay.width < 3 || replay.height < 3 || replay.foodCount < 1 || replay.powerUps < 0)
+    {
+        throw std::invalid_argument("Corrupted replay header");
+    }
+
+    readBlock(input, replay.directions, readValue<std::uint64_t>(input), sizeLimit);
+    if (std::ranges::any_of(replay.directions, [](Direction direction) { return direction > Direction::Right; }))
+    {
+        throw std::invalid_argument("Invalid direction in replay");
+    }
+
+    if (version >= 3)
+    {
+        readBlock(input, replay.keyframes, readValue<std::uint64_t>(input), sizeLimit);
+        readBlock(input, replay.keyframeData, readValue<std::uint64_t>(input), sizeLimit);
+
+        const auto valid = [&](const Keyframe& keyframe)
+        {
+            return keyframe.tick <= replay.directions.size() && keyframe.offset <= replay.keyframeData.size() &&
+                   keyframe.size <= replay.keyframeData.size() - keyframe.offset;
+        };
+        const bool sorted = std::ranges::is_sorted(replay.keyframes, {}, &Keyframe::tick);
+        if (!sorted || !std::ranges::all_of(replay.keyframes, valid))
+        {
+            throw std::invalid_argument("Corrupted keyframe index in replay");
+        }
+    }
+
+    return replay;
+}
+
+void saveReplay(const Replay& replay, const std::filesystem::path& path)
+{
+    std::ofstream output(path, std::ios::binary | std::ios::trunc);
+    if (!output)
+    {
+        throw std::runtime_error("Failed to write replay file: " + path.string());
+    }
+
+    writeReplay(output, replay);
+}
+
+Replay loadReplay(const std::filesystem::path& path)
+{
+    std::ifstream input(path, std::ios::binary);
+    if (!input)
+    {
+        throw std::runtime_error("Failed to open replay file: " + path.string());
+    }
+
+    try
+    {
+        return readReplay(input, std::filesystem::file_size(path));
+    }
+    catch (const std::invalid_argument& ex)
+    {
+        throw std::invalid_argument(std::string(ex.what()) + ": " + path.string());
+    }
+}
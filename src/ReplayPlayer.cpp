@@ -0,0 +1,68 @@
+#include "ReplayPlayer.hpp"
+
+#include <algorithm>
+#include <span>
+#include <utility>
+
+ReplayPlayer::ReplayPlayer(const Replay& replay, Board board)
+    : replay_(replay), simulation_(std::move(board), replay.seed, {replay.foodCount, replay.powerUps})
+{
+}
+
+void ReplayPlayer::seek(std::uint64_t tick)
+{
+    tick = std::min<std::uint64_t>(tick, length());
+
+    // Ostatnia klatka kluczowa nie pozniej niz cel (wyszukiwanie binarne).
+    const auto after = std::ranges::upper_bound(replay_.keyframes, tick, {}, &Keyframe::tick);
+    const Keyframe* keyframe = after == replay_.keyframes.begin() ? nullptr : &*std::prev(after);
+
+    // Dogrywanie od biezacego stanu jest tansze, jesli jest blizej celu niz klatka.
+    const std::uint64_t current = simulation_.tick();
+    const bool forwardFromCurrent =
+        !finished_ && current <= tick && (keyframe == nullptr || keyframe->tick <= current);
+
+    if (!forwardFromCurrent)
+    {
+        finished_ = false;
+        if (keyframe == nullptr)
+        {
+            simulation_.reset(replay_.seed);
+        }
+        else
+        {
+            simulation_.readState(std::span(replay_.keyframeData).subspan(keyframe->offset, keyframe->size));
+        }
+    }
+
+    while (simulation_.tick() < tick && stepForward())
+    {
+    }
+}
+
+bool ReplayPlayer::stepForward()
+{
+    if (finished_ || simulation_.tick() >= length())
+    {
+        return false;
+    }
+
+    const StepResult result = simulation_.step(replay_.directions[simulation_.tick()]);
+    finished_ = result == StepResult::HitWall || result == StepResult::HitSelf;
+    return !finished_;
+}
+
+const Simulation& ReplayPlayer::simulation() const
+{
+    return simulation_;
+}
+
+std::uint64_t ReplayPlayer::tick() const
+{
+    return simulation_.tick();
+}
+
+std::uint64_t ReplayPlayer::length() const
+{
+    return replay_.directions.size();
+}
@@ -0,0 +1,63 @@
+#include "ReplayRecorder.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+
+namespace
+{
+// Zapas na kierunki powtorki, zeby zapis nie alokowal w trakcie gry.
+constexpr std::size_t directionReserve = 1 << 20;
+} // namespace
+
+ReplayRecorder::ReplayRecorder()
+{
+    replay_.directions.reserve(directionReserve);
+}
+
+void ReplayRecorder::start(const Simulation& simulation, const std::string& map)
+{
+    // clear() zostawia zarezerwowana pamiec.
+    replay_.seed = simulation.seed();
+    replay_.width = simulation.board().width();
+    replay_.height = simulation.board().height();
+    replay_.map = map;
+    replay_.foodCount = simulation.food().options().foodCount;
+    replay_.powerUps = simulation.food().options().powerUps;
+    replay_.directions.clear();
+    replay_.keyframes.clear();
+    replay_.keyframeData.clear();
+    allocatedLastTick_ = false;
+}
+
+void ReplayRecorder::restore(Replay replay)
+{
+    replay_ = std::move(replay);
+    replay_.directions.reserve(std::max(directionReserve, replay_.directions.size() * 2));
+    allocatedLastTick_ = false;
+}
+
+void ReplayRecorder::record(Direction direction, const Simulation& simulation)
+{
+    const std::size_t capacity = replay_.directions.capacity();
+    replay_.directions.push_back(direction);
+    allocatedLastTick_ = replay_.directions.capacity() != capacity;
+
+    if (simulation.tick() % keyframeInterval == 0)
+    {
+        allocatedLastTick_ = true;
+        const std::size_t offset = replay_.keyframeData.size();
+        simulation.writeState(replay_.keyframeData);
+        replay_.keyframes.push_back({simulation.tick(), offset, replay_.keyframeData.size() - offset});
+    }
+}
+
+bool ReplayRecorder::allocatedLastTick() const
+{
+    return allocatedLastTick_;
+}
+
+const Replay& ReplayRecorder::replay() const
+{
+    return replay_;
+}
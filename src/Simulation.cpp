@@ -0,0 +1,265 @@
+#include "Simulation.hpp"
+
+#include "BinaryIO.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+namespace
+{
+// Ustawienia startowe weza.
+constexpr int initialLength = 3;
+// Czas dzialania bonusow w tikach i liczba segmentow odcinanych przez bonus skrocenia.
+constexpr std::uint32_t powerUpTicks = 50;
+constexpr std::size_t shrinkSegments = 5;
+
+// Czy od pola da sie ulozyc weza w lewo z miejscem na pierwszy ruch w prawo.
+bool fitsSnake(const Board& board, const GridPos& head)
+{
+    for (int dx = -(initialLength - 1); dx <= 1; ++dx)
+    {
+        const GridPos pos{head.x + dx, head.y};
+        if (!board.inside(pos) || !board.passable(board.cell(pos)))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+Cell findStartCell(const Board& board)
+{
+    const GridPos preferred{std::clamp(board.width() / 2, initialLength - 1, board.width() - 1), board.height() / 2};
+    if (!board.hasWalls() || fitsSnake(board, preferred))
+    {
+        return board.cell(preferred);
+    }
+
+    // Na mapie szukamy pierwszego wolnego miejsca wierszami.
+    for (int y = 0; y < board.height(); ++y)
+    {
+        for (int x = initialLength - 1; x < board.width(); ++x)
+        {
+            if (fitsSnake(board, {x, y}))
+            {
+                return board.cell({x, y});
+            }
+        }
+    }
+
+    throw std::invalid_argument("Map has no free place for the snake start");
+}
+} // namespace
+
+Simulation::Simulation(int width, int height, std::uint32_t seed)
+    : Simulation(Board(width, height), seed)
+{
+}
+
+Simulation::Simulation(Board board, std::uint32_t seed, const ItemOptions& items)
+    : board_(std::move(board)),
+      snake_(board_, findStartCell(board_), initialLength, Direction::Right, &arena_),
+      food_(board_, items),
+      random_(seed),
+      start_(snake_.head())
+{
+    food_.reset(board_, snake_, random_);
+}
+
+void Simulation::reset(std::uint32_t seed)
+{
+    snake_.reset(start_, initialLength, Direction::Right);
+    random_.reseed(seed);
+    score_ = 0;
+    tick_ = 0;
+    speedTicks_ = 0;
+    ghostTicks_ = 0;
+    food_.reset(board_, snake_, random_);
+}
+
+StepResult Simulation::step(Direction direction)
+{
+    ++tick_;
+    // Bonusy wygasaja i pojawiaja sie takze w tiku konca gry, wiec kolo czasu nie zostaje w tyle.
+    food_.advance(board_, snake_, random_, tick_);
+    snake_.setDirection(direction);
+    const Cell nextHead = snake_.nextHeadPosition();
+
+    // Kolizja ze sciana.
+    if (!board_.passable(nextHead))
+    {
+        return StepResult::HitWall;
+    }
+
+    // Przedmiot pod glowa z siatki planszy, bez przegladania listy przedmiotow.
+    const Item* item = food_.at(nextHead);
+    const bool grow = item != nullptr && item->kind == ItemKind::Food;
+    snake_.move(grow);
+
+    // Kolizja z wlasnym cialem (bonus ducha pozwala przez nie przejsc).
+    if (snake_.selfCollision() && ghostTicks_ == 0)
+    {
+        return StepResult::HitSelf;
+    }
+
+    if (speedTicks_ > 0)
+    {
+        --speedTicks_;
+    }
+    if (ghostTicks_ > 0)
+    {
+        --ghostTicks_;
+    }
+    if (item != nullptr)
+    {
+        applyPowerUp(item->kind);
+        food_.take(nextHead, board_, snake_, random_, tick_);
+    }
+
+    if (grow)
+    {
+        ++score_;
+        return StepResult::Ate;
+    }
+
+    return StepResult::Moved;
+}
+
+void Simulation::writeState(std::vector<std::byte>& output) const
+{
+    appendValue(output, tick_);
+    appendValue(output, static_cast<std::int32_t>(score_));
+    appendValue(output, snake_.direction());
+    appendValue(output, food_.position());
+    random_.writeState(output);
+
+    // Cialo jako ciagla tablica indeksow.
+    const auto& body = snake_.body();
+    appendValue(output, static_cast<std::uint32_t>(body.size()));
+    const std::vector<Cell> cells(body.begin(), body.end());
+    appendValues(output, std::span<const Cell>(cells));
+
+    // Bonusy i pozostale przedmioty tylko przy wielu przedmiotach (jedno jedzenie zapisujemy jak dotad).
+    if (food_.items().size() > 1)
+    {
+        appendValue(output, speedTicks_);
+        appendValue(output, ghostTicks_);
+        food_.writeState(output);
+    }
+}
+
+void Simulation::readState(std::span<const std::byte> input)
+{
+    ByteReader reader(input);
+    const auto tick = reader.read<std::uint64_t>();
+    const auto score = reader.read<std::int32_t>();
+    const auto direction = reader.read<Direction>();
+    const auto food = reader.read<Cell>();
+    Random random;
+    random.readState(reader);
+
+    const auto length = reader.read<std::uint32_t>();
+    if (length == 0 || length > board_.passableCount() || length * sizeof(Cell) > reader.remaining())
+    {
+        throw std::invalid_argument("Corrupted snake length in saved state");
+    }
+    std::vector<Cell> body(length);
+    reader.readInto(std::span<Cell>(body));
+
+    std::uint32_t speedTicks = 0;
+    std::uint32_t ghostTicks = 0;
+    std::vector<Item> items;
+    const bool manyItems = food_.items().size() > 1;
+    if (manyItems)
+    {
+        speedTicks = reader.read<std::uint32_t>();
+        ghostTicks = reader.read<std::uint32_t>();
+        items = Food::readState(reader);
+    }
+
+    // Pola musza lezec na planszy, zeby tablice zajetosci byly bezpieczne.
+    const auto valid = [&](Cell cell) { return cell < board_.cellCount() && board_.passable(cell); };
+    if (direction > Direction::Right || (!manyItems && !valid(food)) || !std::ranges::all_of(body, valid))
+    {
+        throw std::invalid_argument("Corrupted cells in saved state");
+    }
+
+    if (manyItems)
+    {
+        // Przedmioty sprawdzamy przed zmiana stanu, wiec blad zostawia gre bez zmian.
+        std::vector<Cell> sortedBody = body;
+        std::ranges::sort(sortedBody);
+        food_.restore(items, board_, sortedBody, tick);
+    }
+    else
+    {
+        food_.place(food);
+    }
+
+    snake_.restore(body, direction);
+    random_ = random;
+    score_ = score;
+    tick_ = tick;
+    speedTicks_ = speedTicks;
+    ghostTicks_ = ghostTicks;
+}
+
+const Board& Simulation::board() const
+{
+    return board_;
+}
+
+const Snake& Simulation::snake() const
+{
+    return snake_;
+}
+
+const Food& Simulation::food() const
+{
+    return food_;
+}
+
+int Simulation::score() const
+{
+    return score_;
+}
+
+std::uint32_t Simulation::seed() const
+{
+    return random_.seed();
+}
+
+std::uint64_t Simulation::tick() const
+{
+    return tick_;
+}
+
+bool Simulation::speedBoost() const
+{
+    return speedTicks_ > 0;
+}
+
+bool Simulation::ghost() const
+{
+    return ghostTicks_ > 0;
+}
+
+void Simulation::applyPowerUp(ItemKind kind)
+{
+    switch (kind)
+    {
+    case ItemKind::Speed:
+        speedTicks_ = powerUpTicks;
+        break;
+    case ItemKind::Shrink:
+        snake_.shrink(shrinkSegments, initialLength);
+        break;
+    case ItemKind::Ghost:
+        ghostTicks_ = powerUpTicks;
+        break;
+    case ItemKind::Food:
+    default:
+        break;
+    }
+}
@@ -1,52 +1,57 @@
 #include "Snake.hpp"
 
-#include <algorithm>
-#include <iterator>
-#include <ranges>
-
-namespace
-{
-// Zamiana kierunku na przesuniecie na siatce
-GridPos directionOffset(Direction direction)
-{
-    switch (direction)
-    {
-    case Direction::Up:
-        return {0, -1};
-    case Direction::Down:
-        return {0, 1};
-    case Direction::Left:
-        return {-1, 0};
-    case Direction::Right:
-    default:
-        return {1, 0};
-    }
-}
-} // namespace
-
-Snake::Snake(const GridPos& start, int initialLength, Direction direction)
+Snake::Snake(const Board& board,
+             Cell start,
+             int initialLength,
+             Direction direction,
+             std::pmr::memory_resource* memory)
+    : body_(memory), occupancy_(board.cellCount(), 0, memory), steps_(board.steps())
 {
     reset(start, initialLength, direction);
 }
 
-void Snake::reset(const GridPos& start, int initialLength, Direction direction)
+void Snake::reset(Cell start, int initialLength, Direction direction)
 {
+    // Czyscimy tylko pola starego ciala, nie cala plansze.
+    for (const Cell segment : body_)
+    {
+        occupancy_[segment] = 0;
+    }
+    occupiedCells_ = 0;
     body_.clear();
     direction_ = direction;
 
     // Ustawiamy ogon za glowa na osi X.
     for (int i = 0; i < initialLength; ++i)
     {
-        body_.push_back({start.x - i, start.y});
+        const Cell segment = start - static_cast<Cell>(i);
+        body_.push_back(segment);
+        occupy(segment);
     }
 }
 
-const std::deque<GridPos>& Snake::body() const
+void Snake::restore(std::span<const Cell> body, Direction direction)
+{
+    for (const Cell segment : body_)
+    {
+        occupancy_[segment] = 0;
+    }
+    occupiedCells_ = 0;
+    body_.assign(body.begin(), body.end());
+    direction_ = direction;
+
+    for (const Cell segment : body_)
+    {
+        occupy(segment);
+    }
+}
+
+const std::pmr::deque<Cell>& Snake::body() const
 {
     return body_;
 }
 
-GridPos Snake::head() const
+Cell Snake::head() const
 {
     return body_.front();
 }
@@ -61,36 +66,56 @@ void Snake::setDirection(Direction direction)
     direction_ = direction;
 }
 
-GridPos Snake::nextHeadPosition() const
+Cell Snake::nextHeadPosition() const
 {
-    return head() + directionOffset(direction_);
+    return neighbor(head(), steps_[static_cast<std::size_t>(direction_)]);
 }
 
 void Snake::move(bool grow)
 {
-    body_.push_front(nextHeadPosition());
+    const Cell next = nextHeadPosition();
+    body_.push_front(next);
+    occupy(next);
 
     if (!grow)
     {
+        release(body_.back());
         body_.pop_back();
     }
 }
 
-bool Snake::occupies(const GridPos& pos) const
+void Snake::shrink(std::size_t segments, std::size_t minLength)
 {
-    return std::ranges::find(body_, pos) != body_.end();
+    while (segments-- > 0 && body_.size() > minLength)
+    {
+        release(body_.back());
+        body_.pop_back();
+    }
 }
 
 bool Snake::selfCollision() const
 {
-    if (body_.size() < 2)
+    // Glowa nie moze wchodzic w reszte ciala
+    return occupancy_[head()] > 1;
+}
+
+std::size_t Snake::occupiedCells() const
+{
+    return occupiedCells_;
+}
+
+void Snake::occupy(Cell cell)
+{
+    if (occupancy_[cell]++ == 0)
     {
-        return false;
+        ++occupiedCells_;
     }
+}
 
-    // Glowa nie moze wchodzic w reszte ciala
-    const auto& headPos = body_.front();
-    return std::ranges::any_of(std::next(body_.begin()), body_.end(),
-                               [&](const GridPos& segment)
-                               { return segment == headPos; });
+void Snake::release(Cell cell)
+{
+    if (--occupancy_[cell] == 0)
+    {
+        --occupiedCells_;
+    }
 }
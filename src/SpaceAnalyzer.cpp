@@ -0,0 +1,218 @@
+#include "SpaceAnalyzer.hpp"
+
+#include <algorithm>
+
+namespace
+{
+constexpr std::array<Direction, 4> allDirections{Direction::Up, Direction::Down, Direction::Left, Direction::Right};
+} // namespace
+
+const SpaceReport& SpaceAnalyzer::analyze(const Simulation& simulation)
+{
+    const Board& board = simulation.board();
+    const Snake& snake = simulation.snake();
+    const Cell tail = snake.body().back();
+    // Obszar wiekszy od weza albo z ogonem wystarcza do oceny ruchu, wiec dalej nie liczymy.
+    const auto limit = static_cast<std::uint32_t>(snake.body().size()) + 1;
+    beginPass(board);
+
+    report_.moveCount = 0;
+    std::array<Region, 3> regions{};
+    std::uint32_t regionCount = 0;
+
+    for (const Direction direction : allDirections)
+    {
+        if (areOpposite(snake.direction(), direction))
+        {
+            continue;
+        }
+
+        MoveSpace& move = report_.moves[report_.moveCount++];
+        move = {direction, false, 0, false};
+
+        const Cell next = neighbor(snake.head(), board.step(direction));
+        // Na ogon mozna wejsc, chyba ze waz wlasnie zje i ogon zostanie na miejscu.
+        if (!isFree(simulation, next) || (next == tail && simulation.food().hasFood(next)))
+        {
+            continue;
+        }
+        move.safe = true;
+
+        // Ruchy do tego samego obszaru dziela jedno wypelnianie.
+        if (seen_[next] != stamp_)
+        {
+            regions[regionCount] = fillRegion(simulation, next, regionCount, limit, regions);
+            ++regionCount;
+        }
+        const Region& region = regions[label_[next]];
+        move.regionSize = region.size;
+        move.tailReachable = region.tailReachable;
+    }
+
+    return report_;
+}
+
+std::span<const Cell> SpaceAnalyzer::chokePoints(const Simulation& simulation)
+{
+    const Board& board = simulation.board();
+    const Snake& snake = simulation.snake();
+    beginPass(board);
+
+    if (order_.size() != board.cellCount())
+    {
+        order_.assign(board.cellCount(), 0);
+        low_.assign(board.cellCount(), 0);
+        parent_.assign(board.cellCount(), 0);
+        cut_.assign(board.cellCount(), 0);
+    }
+    chokePoints_.clear();
+
+    const auto markCut = [this](Cell cell)
+    {
+        if (cut_[cell] != stamp_)
+        {
+            cut_[cell] = stamp_;
+            chokePoints_.push_back(cell);
+        }
+    };
+
+    // Tarjan iteracyjnie (na duzej mapie rekurencja przepelnilaby stos) od kazdego sasiada glowy.
+    std::uint32_t time = 0;
+    for (const Direction direction : allDirections)
+    {
+        const Cell root = neighbor(snake.head(), board.step(direction));
+        if (!isFree(simulation, root) || seen_[root] == stamp_)
+        {
+            continue;
+        }
+
+        seen_[root] = stamp_;
+        order_[root] = low_[root] = ++time;
+        parent_[root] = root;
+        std::uint32_t rootChildren = 0;
+        stack_.push_back({root, 0});
+
+        while (!stack_.empty())
+        {
+            DfsFrame& frame = stack_.back();
+            const Cell cell = frame.cell;
+
+            if (frame.nextDirection < allDirections.size())
+            {
+                const Cell next = neighbor(cell, board.step(allDirections[frame.nextDirection++]));
+                if (!isFree(simulation, next))
+                {
+                    continue;
+                }
+                if (seen_[next] != stamp_)
+                {
+                    seen_[next] = stamp_;
+                    order_[next] = low_[next] = ++time;
+                    parent_[next] = cell;
+                    if (cell == root)
+                    {
+                        ++rootChildren;
+                    }
+                    // Uwaga: push_back moze uniewaznic referencje frame.
+                    stack_.push_back({next, 0});
+                }
+                else if (next != parent_[cell])
+                {
+                    low_[cell] = std::min(low_[cell], order_[next]);
+                }
+                continue;
+            }
+
+            stack_.pop_back();
+            if (cell == root)
+            {
+                continue;
+            }
+            const Cell up = parent_[cell];
+            low_[up] = std::min(low_[up], low_[cell]);
+            if (up != root && low_[cell] >= order_[up])
+            {
+                markCut(up);
+            }
+        }
+
+        // Korzen dzieli obszar, gdy ma wiecej niz jedno poddrzewo.
+        if (rootChildren > 1)
+        {
+            markCut(root);
+        }
+    }
+
+    return chokePoints_;
+}
+
+bool SpaceAnalyzer::isFree(const Simulation& simulation, Cell cell) const
+{
+    const Snake& snake = simulation.snake();
+    return simulation.board().passable(cell) && (!snake.occupies(cell) || cell == snake.body().back());
+}
+
+void SpaceAnalyzer::beginPass(const Board& board)
+{
+    if (seen_.size() != board.cellCount())
+    {
+        seen_.assign(board.cellCount(), 0);
+        label_.assign(board.cellCount(), 0);
+        queue_.resize(board.cellCount());
+        stamp_ = 0;
+    }
+
+    // Po przepelnieniu licznika epok stare znaczniki moglyby udawac biezace.
+    if (++stamp_ == 0)
+    {
+        std::fill(seen_.begin(), seen_.end(), 0);
+        std::fill(cut_.begin(), cut_.end(), 0);
+        stamp_ = 1;
+    }
+}
+
+SpaceAnalyzer::Region SpaceAnalyzer::fillRegion(const Simulation& simulation,
+                                                Cell start,
+                                                std::uint32_t label,
+                                                std::uint32_t limit,
+                                                std::span<const Region> earlier)
+{
+    const Board& board = simulation.board();
+    const Cell tailCell = simulation.snake().body().back();
+
+    // Kolejka BFS w stalym buforze: kazde pole trafia do niej najwyzej raz.
+    std::size_t head = 0;
+    std::size_t tail = 0;
+    queue_[tail++] = start;
+    seen_[start] = stamp_;
+    label_[start] = label;
+
+    Region region{1, start == tailCell};
+    while (head < tail && !region.tailReachable && region.size < limit)
+    {
+        const Cell cell = queue_[head++];
+        for (const std::int32_t step : board.steps())
+        {
+            const Cell next = neighbor(cell, step);
+            if (seen_[next] == stamp_)
+            {
+                // Pole z przerwanego wczesniej wypelniania: ten sam obszar i ta sama ocena.
+                if (label_[next] != label)
+                {
+                    return earlier[label_[next]];
+                }
+                continue;
+            }
+            if (isFree(simulation, next))
+            {
+                seen_[next] = stamp_;
+                label_[next] = label;
+                queue_[tail++] = next;
+                ++region.size;
+                region.tailReachable = region.tailReachable || next == tailCell;
+            }
+        }
+    }
+
+    return region;
+}
@@ -0,0 +1,359 @@
+#include "SpectatorView.hpp"
+
+#include "BoardRenderer.hpp"
+#include "LevelMap.hpp"
+#include "MassSimulation.hpp"
+
+#include <SFML/Window/Event.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <format>
+#include <optional>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+const sf::Color boardColor(30, 30, 34);
+const sf::Color wallColor(90, 90, 110);
+const sf::Color snakeColor(30, 160, 60);
+const sf::Color headColor(120, 220, 120);
+
+// Odstep miedzy planszami w pikselach.
+constexpr float gap = 4.F;
+// Miejsce na wiersz statusu nad siatka.
+constexpr float statusHeight = 28.F;
+constexpr float maxBacklogSeconds = 0.25F;
+} // namespace
+
+SpectatorView::SpectatorView(const Config& config,
+                             const std::filesystem::path& dataDir,
+                             int games,
+                             Policy policy,
+                             std::uint64_t maxTicks)
+    : config_(config),
+      policy_(policy),
+      nextSeed_(Random::makeSeed()),
+      window_(sf::VideoMode({sf::VideoMode::getDesktopMode().size.x * 9 / 10,
+                             sf::VideoMode::getDesktopMode().size.y * 9 / 10}),
+              "Snake - spectator"),
+      statusText_(font_, "", 18)
+{
+    if (games < 1 || games > 1024)
+    {
+        throw std::invalid_argument("Spectator game count must be between 1 and 1024");
+    }
+
+    window_.setFramerateLimit(60);
+    tickSeconds_ = static_cast<float>(config_.tickMs) / 1000.F;
+
+    const auto fontPath = dataDir / fontFile;
+    if (!font_.openFromFile(fontPath))
+    {
+        throw std::runtime_error("Failed to load font: " + fontPath.string());
+    }
+    statusText_.setFillColor(sf::Color::White);
+    statusText_.setPosition({gap, 2.F});
+
+    // Wszystkie gry na tej samej planszy, kazda z innym ziarnem.
+    const Board board = makeBoard(config_, dataDir);
+    maxTicks_ = resolveMaxTicks(board, maxTicks);
+    const ItemOptions items{config_.foodCount, config_.powerUps};
+    games_.reserve(static_cast<std::size_t>(games));
+    policyStates_.resize(static_cast<std::size_t>(games));
+    for (int i = 0; i < games; ++i)
+    {
+        games_.push_back(std::make_unique<Simulation>(board, nextSeed_, items));
+        policyStates_[static_cast<std::size_t>(i)].random.reseed(~nextSeed_);
+        ++nextSeed_;
+    }
+
+    layout(window_.getSize());
+    updateTexts();
+}
+
+void SpectatorView::run()
+{
+    stepper_ = std::jthread([this](std::stop_token stopToken) { stepLoop(stopToken); });
+
+    while (window_.isOpen())
+    {
+        handleEvents();
+        render();
+    }
+
+    stepper_.request_stop();
+    stepper_.join();
+}
+
+void SpectatorView::handleEvents()
+{
+    while (const std::optional<sf::Event> event = window_.pollEvent())
+    {
+        if (event->is<sf::Event::Closed>())
+        {
+            window_.close();
+        }
+        else if (const auto* resized = event->getIf<sf::Event::Resized>())
+        {
+            layout(resized->size);
+        }
+        else if (const auto* key = event->getIf<sf::Event::KeyPressed>())
+        {
+            if (key->code == sf::Keyboard::Key::Escape)
+            {
+                window_.close();
+            }
+            else if (key->code == sf::Keyboard::Key::P)
+            {
+                {
+                    const std::scoped_lock lock(mutex_);
+                    paused_ = !paused_;
+                }
+                wake_.notify_one();
+                updateTexts();
+            }
+        }
+    }
+}
+
+void SpectatorView::stepLoop(std::stop_token stopToken)
+{
+    using Clock = std::chrono::steady_clock;
+    const auto tick = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float>(tickSeconds_));
+    const auto maxBacklog =
+        std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float>(maxBacklogSeconds));
+
+    std::vector<Viewport> viewports;
+    std::uint64_t generation = 0;
+    auto nextTick = Clock::now();
+
+    while (!stopToken.stop_requested())
+    {
+        bool paused = false;
+        bool relayout = false;
+        {
+            std::unique_lock lock(mutex_);
+            const auto layoutChanged = [&] { return layoutGeneration_ != generation; };
+            if (paused_)
+            {
+                // W pauzie czekamy na wznowienie; nowy uklad okna tylko przebudowuje wierzcholki.
+                wake_.wait(lock, stopToken, [&] { return !paused_ || layoutChanged(); });
+                nextTick = Clock::now() + tick;
+            }
+            else
+            {
+                wake_.wait_until(lock, stopToken, nextTick, [&] { return paused_ || layoutChanged(); });
+            }
+            if (stopToken.stop_requested())
+            {
+                return;
+            }
+            if (layoutChanged())
+            {
+                viewports = viewports_;
+                generation = layoutGeneration_;
+                relayout = true;
+            }
+            paused = paused_;
+        }
+
+        bool stepped = false;
+        if (!paused)
+        {
+            // Po dlugiej przerwie (np. przeciaganie okna) nie nadrabiamy wszystkich tikow.
+            const auto now = Clock::now();
+            nextTick = std::max(nextTick, now - maxBacklog);
+            while (nextTick <= now)
+            {
+                stepGames();
+                nextTick += tick;
+                stepped = true;
+            }
+        }
+
+        if (stepped || relayout)
+        {
+            buildVertices(viewports);
+            const std::scoped_lock lock(mutex_);
+            std::swap(workVertices_, readyVertices_);
+            verticesReady_ = true;
+        }
+    }
+}
+
+void SpectatorView::stepGames()
+{
+    for (std::size_t i = 0; i < games_.size(); ++i)
+    {
+        Simulation& game = *games_[i];
+        const StepResult result = game.step(choosePolicyMove(policy_, game, policyStates_[i]));
+        const bool died = result == StepResult::HitWall || result == StepResult::HitSelf;
+        // Zapetlona strategia bez jedzenia konczy sie po limicie tikow, jak w --simulate.
+        if (!died && game.tick() < maxTicks_)
+        {
+            continue;
+        }
+
+        // Skonczona gra od razu zaczyna sie od nowa z kolejnym ziarnem.
+        bestScore_.store(std::max(bestScore_.load(std::memory_order_relaxed), game.score()),
+                         std::memory_order_relaxed);
+        if (!died)
+        {
+            timedOutGames_.fetch_add(1, std::memory_order_relaxed);
+        }
+        // Okno czyta licznik z acquire, wiec widzi tez nowy wynik.
+        finishedGames_.fetch_add(1, std::memory_order_release);
+        game.reset(nextSeed_);
+        policyStates_[i].random.reseed(~nextSeed_);
+        ++nextSeed_;
+    }
+}
+
+void SpectatorView::buildVertices(const std::vector<Viewport>& viewports)
+{
+    // Weze i jedzenie wszystkich gier w jednej tablicy; bufory zachowuja pojemnosc miedzy tikami.
+    workVertices_.clear();
+    for (std::size_t i = 0; i < games_.size(); ++i)
+    {
+        const Simulation& game = *games_[i];
+        const Board& board = game.board();
+        const Viewport& viewport = viewports[i];
+        const sf::Vector2f tileSize{viewport.tile, viewport.tile};
+
+        const auto tileOrigin = [&](Cell cell)
+        {
+            const GridPos pos = board.position(cell);
+            return sf::Vector2f{viewport.origin.x + static_cast<float>(pos.x) * viewport.tile,
+                                viewport.origin.y + static_cast<float>(pos.y) * viewport.tile};
+        };
+
+        for (const Item& item : game.food().items())
+        {
+            if (item.active)
+            {
+                appendQuad(workVertices_, tileOrigin(item.cell), tileSize, itemColor(item.kind));
+            }
+        }
+        bool head = true;
+        for (const Cell cell : game.snake().body())
+        {
+            appendQuad(workVertices_, tileOrigin(cell), tileSize, head ? headColor : snakeColor);
+            head = false;
+        }
+    }
+}
+
+void SpectatorView::render()
+{
+    window_.clear(sf::Color(18, 18, 18));
+
+    if (useStaticBuffer_)
+    {
+        window_.draw(staticBuffer_);
+    }
+    else
+    {
+        window_.draw(staticVertices_.data(), staticVertices_.size(), sf::PrimitiveType::Triangles);
+    }
+
+    {
+        const std::scoped_lock lock(mutex_);
+        if (verticesReady_)
+        {
+            std::swap(readyVertices_, dynamicVertices_);
+            verticesReady_ = false;
+        }
+    }
+    if (finishedGames_.load(std::memory_order_acquire) != shownFinishedGames_)
+    {
+        updateTexts();
+    }
+
+    window_.draw(dynamicVertices_.data(), dynamicVertices_.size(), sf::PrimitiveType::Triangles);
+
+    window_.draw(statusText_);
+    window_.display();
+}
+
+void SpectatorView::layout(sf::Vector2u windowSize)
+{
+    window_.setView(sf::View(sf::FloatRect({0.F, 0.F}, sf::Vector2f(windowSize))));
+
+    const Board& board = games_.front()->board();
+    const auto boardWidth = static_cast<float>(board.width());
+    const auto boardHeight = static_cast<float>(board.height());
+    const auto areaWidth = static_cast<float>(windowSize.x);
+    const float areaHeight = static_cast<float>(windowSize.y) - statusHeight;
+    const auto count = static_cast<int>(games_.size());
+
+    // Liczba kolumn dajaca najwieksze pola przy tej proporcji okna.
+    int columns = 1;
+    float tile = 0.F;
+    for (int candidate = 1; candidate <= count; ++candidate)
+    {
+        const int rows = (count + candidate - 1) / candidate;
+        const float cellWidth = areaWidth / static_cast<float>(candidate) - gap;
+        const float cellHeight = areaHeight / static_cast<float>(rows) - gap;
+        const float candidateTile = std::min(cellWidth / boardWidth, cellHeight / boardHeight);
+        if (candidateTile > tile)
+        {
+            tile = candidateTile;
+            columns = candidate;
+        }
+    }
+
+    std::vector<Viewport> viewports;
+    staticVertices_.clear();
+    const sf::Vector2f boardSize{boardWidth * tile, boardHeight * tile};
+    for (int i = 0; i < count; ++i)
+    {
+        const sf::Vector2f origin{gap + static_cast<float>(i % columns) * (boardSize.x + gap),
+                                  statusHeight + static_cast<float>(i / columns) * (boardSize.y + gap)};
+        viewports.push_back({origin, tile});
+
+        appendQuad(staticVertices_, origin, boardSize, boardColor);
+        if (!board.hasWalls())
+        {
+            continue;
+        }
+        for (int y = 0; y < board.height(); ++y)
+        {
+            for (int x = 0; x < board.width(); ++x)
+            {
+                if (!board.passable(board.cell({x, y})))
+                {
+                    appendQuad(staticVertices_,
+                               {origin.x + static_cast<float>(x) * tile, origin.y + static_cast<float>(y) * tile},
+                               {tile, tile},
+                               wallColor);
+                }
+            }
+        }
+    }
+
+    // Warstwa statyczna trafia do pamieci karty raz; bez VBO rysujemy ja z tablicy.
+    useStaticBuffer_ = sf::VertexBuffer::isAvailable() && staticBuffer_.create(staticVertices_.size()) &&
+                       staticBuffer_.update(staticVertices_.data());
+
+    // Watek gier przebuduje weze i jedzenie dla nowej siatki.
+    {
+        const std::scoped_lock lock(mutex_);
+        viewports_ = std::move(viewports);
+        ++layoutGeneration_;
+    }
+    wake_.notify_one();
+}
+
+void SpectatorView::updateTexts()
+{
+    shownFinishedGames_ = finishedGames_.load(std::memory_order_acquire);
+    statusText_.setString(std::format("{} games ({})  finished: {} (timeouts: {})  best score: {}{}",
+                                      games_.size(),
+                                      policyName(policy_),
+                                      shownFinishedGames_,
+                                      timedOutGames_.load(std::memory_order_relaxed),
+                                      bestScore_.load(std::memory_order_relaxed),
+                                      paused_ ? "  PAUSED" : ""));
+}
@@ -0,0 +1,251 @@
+#include "Tournament.hpp"
+
+#include "MassSimulation.hpp"
+#include "Simulation.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <format>
+#include <print>
+#include <stdexcept>
+#include <thread>
+
+namespace
+{
+// Gry w bloku; po kazdym pelnym bloku sprawdzamy warunek zatrzymania.
+constexpr std::uint64_t blockGames = 64;
+// Kwantyl rozkladu normalnego dla 95% przedzialu.
+constexpr double z95 = 1.96;
+const auto progressInterval = std::chrono::seconds(1);
+
+// Srednia i wariancja liczone przyrostowo (Welford).
+class RunningStats
+{
+public:
+    void add(double value)
+    {
+        ++count_;
+        const double delta = value - mean_;
+        mean_ += delta / static_cast<double>(count_);
+        m2_ += delta * (value - mean_);
+    }
+
+    ScoreEstimate estimate() const
+    {
+        if (count_ < 2)
+        {
+            return {mean_, 0.0};
+        }
+        const double variance = m2_ / static_cast<double>(count_ - 1);
+        return {mean_, z95 * std::sqrt(variance / static_cast<double>(count_))};
+    }
+
+private:
+    std::uint64_t count_{0};
+    double mean_{0.0};
+    double m2_{0.0};
+};
+
+void playBlocks(const Board& board,
+                const TournamentOptions& options,
+                std::uint64_t maxTicks,
+                std::atomic<std::uint64_t>& nextBlock,
+                std::vector<std::atomic<bool>>& blockDone,
+                std::vector<int>& scores,
+                std::atomic<bool>& stop,
+                std::atomic<std::uint64_t>& playedGames,
+                std::atomic<std::uint64_t>& playedTicks)
+{
+    Simulation simulation(board, options.seed, options.items);
+    std::vector<PolicyState> states(options.policies.size());
+    const std::size_t policyCount = options.policies.size();
+
+    while (!stop.load(std::memory_order_relaxed))
+    {
+        const std::uint64_t block = nextBlock.fetch_add(1, std::memory_order_relaxed);
+        if (block >= blockDone.size())
+        {
+            return;
+        }
+
+        std::uint64_t ticks = 0;
+        const std::uint64_t first = block * blockGames;
+        const std::uint64_t last = std::min(first + blockGames, options.maxGames);
+        for (std::uint64_t game = first; game < last; ++game)
+        {
+            const auto seed = static_cast<std::uint32_t>(options.seed + game);
+            for (std::size_t p = 0; p < policyCount; ++p)
+            {
+                const GameOutcome outcome = playPolicyGame(simulation, options.policies[p], states[p], seed, maxTicks);
+                scores[game * policyCount + p] = outcome.score;
+                ticks += outcome.ticks;
+            }
+        }
+
+        playedGames.fetch_add(last - first, std::memory_order_relaxed);
+        playedTicks.fetch_add(ticks, std::memory_order_relaxed);
+        // Wyniki bloku sa widoczne dla watku glownego po odczycie flagi (acquire).
+        blockDone[block].store(true, std::memory_order_release);
+    }
+}
+
+// Czy kazda para ma dostatecznie waski przedzial roznicy. Zatrzymanie zalezy tylko od
+// szerokosci, nie od znaku roznicy, wiec powtarzane sprawdzanie nie zawyza liczby
+// falszywych zwyciestw jak zatrzymanie przy pierwszym przedziale bez zera.
+bool settled(const std::vector<RunningStats>& differences, double halfWidth)
+{
+    return std::ranges::all_of(differences,
+                               [halfWidth](const RunningStats& stats)
+                               { return stats.estimate().halfWidth <= halfWidth; });
+}
+} // namespace
+
+TournamentResult runTournament(const Board& board, const TournamentOptions& options)
+{
+    if (options.policies.size() < 2)
+    {
+        throw std::invalid_argument("Tournament needs at least two policies");
+    }
+
+    TournamentResult result;
+    result.threads = options.threads != 0 ? options.threads : std::max(1U, std::thread::hardware_concurrency());
+    const std::uint64_t maxTicks = resolveMaxTicks(board, options.maxTicks);
+    const std::size_t policyCount = options.policies.size();
+
+    // Wyniki gier w tablicy [gra][strategia]; kazdy blok zapisuje jeden watek.
+    std::vector<int> scores(options.maxGames * policyCount);
+    std::vector<std::atomic<bool>> blockDone((options.maxGames + blockGames - 1) / blockGames);
+    std::atomic<std::uint64_t> nextBlock{0};
+    std::atomic<bool> stop{false};
+    std::atomic<std::uint64_t> playedGames{0};
+    std::atomic<std::uint64_t> playedTicks{0};
+
+    std::vector<RunningStats> policyStats(policyCount);
+    std::vector<RunningStats> pairStats;
+    for (std::size_t a = 0; a < policyCount; ++a)
+    {
+        for (std::size_t b = a + 1; b < policyCount; ++b)
+        {
+            result.pairs.push_back({a, b, {}});
+            pairStats.emplace_back();
+        }
+    }
+
+    const auto started = std::chrono::steady_clock::now();
+    {
+        std::vector<std::jthread> workers;
+        for (unsigned int i = 0; i < result.threads; ++i)
+        {
+            workers.emplace_back(
+                [&]
+                {
+                    playBlocks(board,
+                               options,
+                               maxTicks,
+                               nextBlock,
+                               blockDone,
+                               scores,
+                               stop,
+                               playedGames,
+                               playedTicks);
+                });
+        }
+
+        // Statystyki skladamy z kolejnych pelnych blokow w kolejnosci gier, wiec moment
+        // zatrzymania i wynik nie zaleza od tego, ktory watek skonczyl pierwszy.
+        std::size_t completed = 0;
+        auto nextReport = started + progressInterval;
+        while (completed < blockDone.size() && !stop.load(std::memory_order_relaxed))
+        {
+            if (!blockDone[completed].load(std::memory_order_acquire))
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(2));
+                if (std::chrono::steady_clock::now() >= nextReport)
+                {
+                    std::println(stderr, "{} paired games", result.games);
+                    nextReport += progressInterval;
+                }
+                continue;
+            }
+
+            const std::uint64_t first = completed * blockGames;
+            const std::uint64_t last = std::min(first + blockGames, options.maxGames);
+            for (std::uint64_t game = first; game < last; ++game)
+            {
+                const int* row = &scores[game * policyCount];
+                for (std::size_t p = 0; p < policyCount; ++p)
+                {
+                    policyStats[p].add(row[p]);
+                }
+                for (std::size_t i = 0; i < result.pairs.size(); ++i)
+                {
+                    pairStats[i].add(row[result.pairs[i].first] - row[result.pairs[i].second]);
+                }
+            }
+            result.games = last;
+            ++completed;
+
+            if (result.games >= options.minGames && completed < blockDone.size() &&
+                settled(pairStats, options.ciHalfWidth))
+            {
+                result.stoppedEarly = true;
+                stop.store(true, std::memory_order_relaxed);
+            }
+        }
+    }
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    result.playedGames = playedGames.load();
+    result.playedTicks = playedTicks.load();
+
+    for (const RunningStats& stats : policyStats)
+    {
+        result.scores.push_back(stats.estimate());
+    }
+    for (std::size_t i = 0; i < result.pairs.size(); ++i)
+    {
+        result.pairs[i].difference = pairStats[i].estimate();
+    }
+    return result;
+}
+
+void writeTournamentJson(std::ostream& output, const TournamentResult& result, const TournamentOptions& options)
+{
+    output << "{\n";
+    output << std::format("  \"games\": {},\n  \"stoppedEarly\": {},\n  \"seed\": {},\n  \"threads\": {},\n",
+                          result.games,
+                          result.stoppedEarly,
+                          options.seed,
+                          result.threads);
+    output << std::format("  \"seconds\": {:.3f},\n  \"playedGames\": {},\n  \"gamesPerSecond\": {:.1f},\n"
+                          "  \"ticksPerSecond\": {:.0f},\n",
+                          result.seconds,
+                          result.playedGames,
+                          result.seconds > 0.0 ? static_cast<double>(result.playedGames) / result.seconds : 0.0,
+                          result.seconds > 0.0 ? static_cast<double>(result.playedTicks) / result.seconds : 0.0);
+
+    output << "  \"policies\": [\n";
+    for (std::size_t i = 0; i < result.scores.size(); ++i)
+    {
+        output << std::format("    {{\"policy\": \"{}\", \"meanScore\": {:.3f}, \"ci95\": {:.3f}}}{}\n",
+                              policyName(options.policies[i]),
+                              result.scores[i].mean,
+                              result.scores[i].halfWidth,
+                              i + 1 < result.scores.size() ? "," : "");
+    }
+    output << "  ],\n  \"pairs\": [\n";
+    for (std::size_t i = 0; i < result.pairs.size(); ++i)
+    {
+        const PairResult& pair = result.pairs[i];
+        output << std::format("    {{\"first\": \"{}\", \"second\": \"{}\", \"meanDifference\": {:.3f}, "
+                              "\"ci95\": {:.3f}}}{}\n",
+                              policyName(options.policies[pair.first]),
+                              policyName(options.policies[pair.second]),
+                              pair.difference.mean,
+                              pair.difference.halfWidth,
+                              i + 1 < result.pairs.size() ? "," : "");
+    }
+    output << "  ]\n}\n";
+}
@@ -0,0 +1,287 @@
+#include "Tracer.hpp"
+
+#include <cstdio>
+#include <format>
+#include <iterator>
+#include <print>
+#include <stdexcept>
+#include <utility>
+
+namespace
+{
+// Limit buforow (kolejka i pula maja tyle miejsca, wiec nie rosna w tiku).
+// Gdy zapis nie nadaza za gra, kolejne zdarzenia przepadaja zamiast alokowac bez konca.
+constexpr std::size_t maxBatches = 64;
+// Bufory przygotowane przy wlaczeniu: pierwszy zakres w watku i wymiana pelnego bufora
+// nie alokuja w tiku (sprawdzanym przez SNAKE_COUNT_ALLOCATIONS).
+constexpr std::size_t spareBatches = 4;
+
+// Bufor watku; przy konczeniu watku resztka zdarzen idzie do zapisu.
+struct ThreadBuffer
+{
+    std::unique_ptr<Tracer::Batch> batch;
+
+    ~ThreadBuffer()
+    {
+        if (batch && Tracer::instance().enabled())
+        {
+            Tracer::instance().detach(std::move(batch));
+        }
+    }
+};
+
+thread_local ThreadBuffer threadBuffer;
+
+double toMicroseconds(std::int64_t nanoseconds)
+{
+    return static_cast<double>(nanoseconds) / 1000.0;
+}
+} // namespace
+
+Tracer& Tracer::instance()
+{
+    static Tracer tracer;
+    return tracer;
+}
+
+Tracer::~Tracer()
+{
+    // Bufory watkow moga juz nie istniec; ich zdarzenia oddaje flush() z main.
+    enabled_.store(false, std::memory_order_relaxed);
+    finish();
+}
+
+void Tracer::enable(const std::filesystem::path& path)
+{
+    output_.open(path, std::ios::trunc);
+    if (!output_)
+    {
+        throw std::runtime_error("Failed to write trace: " + path.string());
+    }
+    output_ << "{\"traceEvents\":[\n";
+
+    pending_.reserve(maxBatches);
+    spare_.reserve(maxBatches);
+    for (std::size_t i = 0; i < spareBatches; ++i)
+    {
+        spare_.push_back(std::make_unique<Batch>());
+    }
+    batchCount_ = spareBatches;
+    // Watek wlaczajacy (petla gry) dostaje bufor od razu, a nie w pierwszym zakresie.
+    attachThread();
+
+    epoch_ = std::chrono::steady_clock::now();
+    writer_ = std::jthread([this](std::stop_token stopToken) { writerLoop(stopToken); });
+    enabled_.store(true, std::memory_order_relaxed);
+}
+
+void Tracer::record(const char* name,
+                    std::chrono::steady_clock::time_point start,
+                    std::chrono::steady_clock::time_point end)
+{
+    attachThread();
+    if (!threadBuffer.batch)
+    {
+        droppedEvents_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    Batch& batch = *threadBuffer.batch;
+    batch.events[batch.count++] = {name,
+                                   std::chrono::duration_cast<std::chrono::nanoseconds>(start - epoch_).count(),
+                                   std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()};
+
+    if (batch.count == Batch::capacity)
+    {
+        const std::uint32_t threadId = batch.threadId;
+        threadBuffer.batch = submit(std::move(threadBuffer.batch));
+        threadBuffer.batch->threadId = threadId;
+    }
+}
+
+std::unique_ptr<Tracer::Batch> Tracer::submit(std::unique_ptr<Batch> batch)
+{
+    std::unique_ptr<Batch> empty;
+    bool allocate = false;
+    {
+        const std::lock_guard lock(mutex_);
+        // Bufory wracaja z watku zapisujacego, wiec po rozgrzewce nie alokujemy.
+        if (!spare_.empty())
+        {
+            empty = std::move(spare_.back());
+            spare_.pop_back();
+        }
+        else if (!reserveBatch())
+        {
+            droppedEvents_.fetch_add(batch->count, std::memory_order_relaxed);
+            batch->count = 0;
+            return batch;
+        }
+        else
+        {
+            allocate = true;
+        }
+        pending_.push_back(std::move(batch));
+    }
+    ready_.notify_one();
+
+    return allocate ? std::make_unique<Batch>() : std::move(empty);
+}
+
+void Tracer::detach(std::unique_ptr<Batch> batch)
+{
+    {
+        const std::lock_guard lock(mutex_);
+        if (batch->count > 0)
+        {
+            pending_.push_back(std::move(batch));
+        }
+        else
+        {
+            spare_.push_back(std::move(batch));
+        }
+    }
+    ready_.notify_one();
+}
+
+void Tracer::attachThread()
+{
+    if (threadBuffer.batch)
+    {
+        return;
+    }
+
+    bool allocate = false;
+    {
+        const std::lock_guard lock(mutex_);
+        if (!spare_.empty())
+        {
+            threadBuffer.batch = std::move(spare_.back());
+            spare_.pop_back();
+        }
+        else
+        {
+            allocate = reserveBatch();
+        }
+    }
+    if (allocate)
+    {
+        threadBuffer.batch = std::make_unique<Batch>();
+    }
+    if (threadBuffer.batch)
+    {
+        threadBuffer.batch->threadId = nextThreadId_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+bool Tracer::reserveBatch()
+{
+    if (batchCount_ == maxBatches)
+    {
+        return false;
+    }
+    ++batchCount_;
+    return true;
+}
+
+void Tracer::flush()
+{
+    if (!enabled_.exchange(false))
+    {
+        return;
+    }
+
+    if (threadBuffer.batch)
+    {
+        detach(std::move(threadBuffer.batch));
+    }
+    finish();
+
+    const std::uint64_t dropped = droppedEvents_.load(std::memory_order_relaxed);
+    if (dropped > 0)
+    {
+        std::println(stderr, "Trace: dropped {} events (writer fell behind)", dropped);
+    }
+}
+
+void Tracer::finish()
+{
+    if (!writer_.joinable())
+    {
+        return;
+    }
+
+    // Watek zapisujacy oproznia kolejke przed zakonczeniem.
+    writer_.request_stop();
+    writer_.join();
+
+    output_ << "\n],\"displayTimeUnit\":\"ms\"}\n";
+    output_.close();
+}
+
+void Tracer::writerLoop(std::stop_token stopToken)
+{
+    std::vector<std::unique_ptr<Batch>> work;
+    work.reserve(maxBatches);
+
+    while (true)
+    {
+        {
+            std::unique_lock lock(mutex_);
+            ready_.wait(lock, stopToken, [this] { return !pending_.empty(); });
+            work.swap(pending_);
+            if (work.empty() && stopToken.stop_requested())
+            {
+                return;
+            }
+        }
+
+        for (const auto& batch : work)
+        {
+            writeBatch(*batch);
+            batch->count = 0;
+        }
+        output_.flush();
+
+        const std::lock_guard lock(mutex_);
+        for (auto& batch : work)
+        {
+            spare_.push_back(std::move(batch));
+        }
+        work.clear();
+    }
+}
+
+void Tracer::writeBatch(const Batch& batch)
+{
+    auto out = std::ostreambuf_iterator<char>(output_);
+    for (std::size_t i = 0; i < batch.count; ++i)
+    {
+        const Event& event = batch.events[i];
+        out = std::format_to(out,
+                             "{}{{\"name\":\"{}\",\"ph\":\"X\",\"pid\":1,\"tid\":{},\"ts\":{:.3f},\"dur\":{:.3f}}}",
+                             firstEvent_ ? "" : ",\n",
+                             event.name,
+                             batch.threadId,
+                             toMicroseconds(event.startNs),
+                             toMicroseconds(event.durationNs));
+        firstEvent_ = false;
+    }
+}
+
+TraceScope::TraceScope(const char* name)
+    : name_(name), active_(Tracer::instance().enabled())
+{
+    if (active_)
+    {
+        start_ = std::chrono::steady_clock::now();
+    }
+}
+
+TraceScope::~TraceScope()
+{
+    if (active_)
+    {
+        Tracer::instance().record(name_, start_, std::chrono::steady_clock::now());
+    }
+}
@@ -0,0 +1,349 @@
+#include "World.hpp"
+
+#include "Random.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iterator>
+
+namespace
+{
+// Zasieg fragmentow w pamieci wokol glowy (w fragmentach).
+constexpr int loadRadius = 2;
+// Ile fragmentow do przodu zamawiamy w kierunku ruchu.
+constexpr int lookahead = 4;
+// Fragmenty dalej niz ten promien i bez weza sa usuwane.
+constexpr int evictRadius = 6;
+// Zamowienia dalej niz ten promien sa juz niepotrzebne i wypadaja z kolejki.
+constexpr int requestRadius = std::max(loadRadius, lookahead);
+
+std::size_t localIndex(const GridPos& pos)
+{
+    const int x = pos.x & (chunkSize - 1);
+    const int y = pos.y & (chunkSize - 1);
+    return static_cast<std::size_t>(y * chunkSize + x);
+}
+
+std::uint32_t chunkSeed(const ChunkKey& key, std::uint32_t worldSeed)
+{
+    // Mieszanie wspolrzednych z ziarnem swiata (splitmix).
+    std::uint64_t value = (static_cast<std::uint64_t>(static_cast<std::uint32_t>(key.x)) << 32) |
+                          static_cast<std::uint32_t>(key.y);
+    value ^= static_cast<std::uint64_t>(worldSeed) * 0x9E3779B97F4A7C15ULL;
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+    return static_cast<std::uint32_t>(value ^ (value >> 31));
+}
+
+int chebyshev(const ChunkKey& lhs, const ChunkKey& rhs)
+{
+    return std::max(std::abs(lhs.x - rhs.x), std::abs(lhs.y - rhs.y));
+}
+} // namespace
+
+std::size_t ChunkKeyHash::operator()(const ChunkKey& key) const
+{
+    return chunkSeed(key, 0);
+}
+
+ChunkKey chunkKeyOf(const GridPos& pos)
+{
+    // Przesuniecie arytmetyczne daje podloge takze dla ujemnych wspolrzednych.
+    return {pos.x >> chunkShift, pos.y >> chunkShift};
+}
+
+std::unique_ptr<Chunk> generateChunk(const ChunkKey& key, std::uint32_t worldSeed)
+{
+    auto chunk = std::make_unique<Chunk>();
+    Random random(chunkSeed(key, worldSeed));
+
+    // Start weza w (0, 0) w prawo: fragmenty po obu stronach zostaja bez scian.
+    const bool spawnArea = key.y == 0 && (key.x == 0 || key.x == -1);
+    if (!spawnArea)
+    {
+        const int obstacles = random.uniformInt(0, 3);
+        for (int i = 0; i < obstacles; ++i)
+        {
+            const int width = random.uniformInt(1, 6);
+            const int height = random.uniformInt(1, 6);
+            const int left = random.uniformInt(0, chunkSize - width);
+            const int top = random.uniformInt(0, chunkSize - height);
+
+            for (int y = top; y < top + height; ++y)
+            {
+                for (int x = left; x < left + width; ++x)
+                {
+                    chunk->terrain.setWall({x, y});
+                }
+            }
+        }
+    }
+
+    const int foodCount = random.uniformInt(1, 4);
+    for (int i = 0; i < foodCount; ++i)
+    {
+        const GridPos pos{random.uniformInt(0, chunkSize - 1), random.uniformInt(0, chunkSize - 1)};
+        if (chunk->terrain.passable(chunk->terrain.cell(pos)))
+        {
+            chunk->food.set(localIndex(pos));
+        }
+    }
+
+    return chunk;
+}
+
+ChunkStreamer::ChunkStreamer(std::uint32_t worldSeed, unsigned int workers)
+    : worldSeed_(worldSeed)
+{
+    for (unsigned int i = 0; i < workers; ++i)
+    {
+        workers_.emplace_back([this](std::stop_token stop) { workerLoop(stop); });
+    }
+}
+
+ChunkStreamer::~ChunkStreamer()
+{
+    // jthread zglasza stop i czeka na watki.
+    workers_.clear();
+}
+
+bool ChunkStreamer::tryRequest(const std::vector<ChunkKey>& keys)
+{
+    std::unique_lock lock(mutex_, std::try_to_lock);
+    if (!lock.owns_lock())
+    {
+        return false;
+    }
+
+    requests_.insert(requests_.end(), keys.begin(), keys.end());
+    lock.unlock();
+    hasWork_.notify_all();
+    return true;
+}
+
+void ChunkStreamer::takeReady(std::vector<std::pair<ChunkKey, std::unique_ptr<Chunk>>>& ready)
+{
+    // Tik nie czeka: jesli watek trzyma blokade, odbierzemy w nastepnym tiku.
+    std::unique_lock lock(mutex_, std::try_to_lock);
+    if (lock.owns_lock())
+    {
+        std::move(ready_.begin(), ready_.end(), std::back_inserter(ready));
+        ready_.clear();
+    }
+}
+
+bool ChunkStreamer::tryDropOutside(const ChunkKey& center, int radius, std::vector<ChunkKey>& dropped)
+{
+    std::unique_lock lock(mutex_, std::try_to_lock);
+    if (!lock.owns_lock())
+    {
+        return false;
+    }
+
+    std::erase_if(requests_,
+                  [&](const ChunkKey& key)
+                  {
+                      if (chebyshev(key, center) <= radius)
+                      {
+                          return false;
+                      }
+                      dropped.push_back(key);
+                      return true;
+                  });
+    return true;
+}
+
+void ChunkStreamer::workerLoop(std::stop_token stop)
+{
+    while (true)
+    {
+        ChunkKey key;
+        {
+            std::unique_lock lock(mutex_);
+            if (!hasWork_.wait(lock, stop, [this] { return !requests_.empty(); }) || stop.stop_requested())
+            {
+                return;
+            }
+            key = requests_.front();
+            requests_.pop_front();
+        }
+
+        auto chunk = generateChunk(key, worldSeed_);
+
+        std::lock_guard lock(mutex_);
+        ready_.emplace_back(key, std::move(chunk));
+    }
+}
+
+World::World(std::uint32_t seed)
+    : seed_(seed),
+      streamer_(seed, std::clamp(std::thread::hardware_concurrency() / 2, 1U, 4U))
+{
+    // Poczatkowe otoczenie generujemy od razu, przed pierwszym tikiem.
+    for (int y = -loadRadius; y <= loadRadius; ++y)
+    {
+        for (int x = -loadRadius; x <= loadRadius; ++x)
+        {
+            chunks_.emplace(ChunkKey{x, y}, generateChunk({x, y}, seed_));
+        }
+    }
+}
+
+void World::update(const GridPos& head, Direction heading)
+{
+    const ChunkKey center = chunkKeyOf(head);
+
+    streamer_.takeReady(ready_);
+    for (auto& [key, chunk] : ready_)
+    {
+        pending_.erase(key);
+        // Fragment, od ktorego waz zdazyl odejsc, od razu zostalby usuniety.
+        if (chebyshev(key, center) <= evictRadius)
+        {
+            insertChunk(key, std::move(chunk));
+        }
+    }
+    ready_.clear();
+
+    if (center != lastCenter_)
+    {
+        evictFar(center);
+        lastCenter_ = center;
+        dropStale_ = true;
+    }
+
+    // Zajeta kolejka: sprobujemy w nastepnym tiku.
+    if (dropStale_)
+    {
+        dropped_.clear();
+        if (streamer_.tryDropOutside(center, requestRadius, dropped_))
+        {
+            for (const ChunkKey& key : dropped_)
+            {
+                pending_.erase(key);
+            }
+            dropStale_ = false;
+        }
+    }
+
+    requestAround(center, heading);
+}
+
+bool World::blocked(const GridPos& pos)
+{
+    const Chunk& chunk = chunkAt(pos);
+    const GridPos local{pos.x & (chunkSize - 1), pos.y & (chunkSize - 1)};
+    return !chunk.terrain.passable(chunk.terrain.cell(local));
+}
+
+bool World::takeFood(const GridPos& pos)
+{
+    Chunk& chunk = chunkAt(pos);
+    const std::size_t index = localIndex(pos);
+    if (!chunk.food.test(index))
+    {
+        return false;
+    }
+    chunk.food.reset(index);
+    eaten_[chunkKeyOf(pos)].set(index);
+    return true;
+}
+
+bool World::snakeAt(const GridPos& pos)
+{
+    return chunkAt(pos).snake.test(localIndex(pos));
+}
+
+void World::setSnake(const GridPos& pos, bool present)
+{
+    Chunk& chunk = chunkAt(pos);
+    const std::size_t index = localIndex(pos);
+    if (chunk.snake.test(index) != present)
+    {
+        chunk.snake.set(index, present);
+        chunk.snakeSegments += present ? 1 : -1;
+    }
+}
+
+const Chunk* World::find(const ChunkKey& key) const
+{
+    const auto it = chunks_.find(key);
+    return it == chunks_.end() ? nullptr : it->second.get();
+}
+
+std::size_t World::loadedChunks() const
+{
+    return chunks_.size();
+}
+
+std::size_t World::missedChunks() const
+{
+    return missedChunks_;
+}
+
+Chunk& World::chunkAt(const GridPos& pos)
+{
+    const ChunkKey key = chunkKeyOf(pos);
+    auto it = chunks_.find(key);
+    if (it == chunks_.end())
+    {
+        // Generowanie nie zdazylo: tik nie czeka, pole staje sie pustym terenem.
+        ++missedChunks_;
+        it = chunks_.emplace(key, std::make_unique<Chunk>()).first;
+    }
+    return *it->second;
+}
+
+void World::insertChunk(const ChunkKey& key, std::unique_ptr<Chunk> chunk)
+{
+    if (const auto it = eaten_.find(key); it != eaten_.end())
+    {
+        chunk->food &= ~it->second;
+    }
+    // Fragment juz uzyty jako pusty teren zostaje bez zmian.
+    chunks_.try_emplace(key, std::move(chunk));
+}
+
+void World::requestAround(const ChunkKey& center, Direction heading)
+{
+    wanted_.clear();
+    const auto want = [&](const ChunkKey& key)
+    {
+        if (!chunks_.contains(key) && !pending_.contains(key) &&
+            std::find(wanted_.begin(), wanted_.end(), key) == wanted_.end())
+        {
+            wanted_.push_back(key);
+        }
+    };
+
+    // Najpierw fragmenty przed glowa, potem otoczenie.
+    const GridPos forward = directionOffset(heading);
+    const GridPos side{forward.y, forward.x};
+    for (int step = 1; step <= lookahead; ++step)
+    {
+        for (int lateral = -1; lateral <= 1; ++lateral)
+        {
+            want({center.x + forward.x * step + side.x * lateral, center.y + forward.y * step + side.y * lateral});
+        }
+    }
+
+    for (int y = -loadRadius; y <= loadRadius; ++y)
+    {
+        for (int x = -loadRadius; x <= loadRadius; ++x)
+        {
+            want({center.x + x, center.y + y});
+        }
+    }
+
+    if (!wanted_.empty() && streamer_.tryRequest(wanted_))
+    {
+        pending_.insert(wanted_.begin(), wanted_.end());
+    }
+}
+
+void World::evictFar(const ChunkKey& center)
+{
+    std::erase_if(chunks_,
+                  [&](const auto& entry)
+                  { return chebyshev(entry.first, center) > evictRadius && entry.second->snakeSegments == 0; });
+}
@@ -1,20 +1,371 @@
+#include "BotLink.hpp"
 #include "Config.hpp"
+#include "EndlessGame.hpp"
+#include "FrameExporter.hpp"
 #include "Game.hpp"
+#include "LevelMap.hpp"
+#include "MassSimulation.hpp"
+#include "PerfCounters.hpp"
+#include "Replay.hpp"
+#include "SpectatorView.hpp"
+#include "Tournament.hpp"
+#include "Tracer.hpp"
 
 #include <cstdio>
 #include <exception>
 #include <filesystem>
+#include <fstream>
+#include <optional>
 #include <print>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
 
-int main()
+namespace
+{
+// Tryb eksportu: snake --export <powtorka> <katalog> [--raw] [--workers N] [--from T] [--to T]
+int runExport(const std::vector<std::string_view>& args, const Config& config, const std::filesystem::path& dataDir)
+{
+    if (args.size() < 3)
+    {
+        throw std::invalid_argument(
+            "Usage: snake --export <replay> <output-dir> [--raw] [--workers N] [--from TICK] [--to TICK]");
+    }
+
+    ExportOptions options;
+    options.outputDir = args[2];
+
+    for (std::size_t i = 3; i < args.size(); ++i)
+    {
+        if (args[i] == "--raw")
+        {
+            options.raw = true;
+        }
+        else if (args[i] == "--workers" && i + 1 < args.size())
+        {
+            options.workers = static_cast<unsigned int>(std::stoul(std::string(args[++i])));
+        }
+        else if (args[i] == "--from" && i + 1 < args.size())
+        {
+            options.firstTick = std::stoull(std::string(args[++i]));
+        }
+        else if (args[i] == "--to" && i + 1 < args.size())
+        {
+            options.lastTick = std::stoull(std::string(args[++i]));
+        }
+        else
+        {
+            throw std::invalid_argument("Unknown export option: " + std::string(args[i]));
+        }
+    }
+
+    const Replay replay = loadReplay(args[1]);
+    const ExportStats stats = exportReplay(replay, config, dataDir, options);
+
+    const double gameSeconds = static_cast<double>(stats.frames) * config.tickMs / 1000.0;
+    std::println("Exported {} frames in {:.2f} s ({:.1f}x real time)",
+                 stats.frames,
+                 stats.seconds,
+                 stats.seconds > 0.0 ? gameSeconds / stats.seconds : 0.0);
+    return 0;
+}
+
+// Masowe gry bez okna: snake --simulate <gry> [--threads N] [--policy greedy|random|space] [--seed S]
+// [--max-ticks T] [--json <plik>]
+int runSimulate(const std::vector<std::string_view>& args, const Config& config, const std::filesystem::path& dataDir)
+{
+    if (args.size() < 2)
+    {
+        throw std::invalid_argument("Usage: snake --simulate <games> [--threads N] [--policy greedy|random|space] "
+                                    "[--seed S] [--max-ticks T] [--json FILE]");
+    }
+
+    MassOptions options;
+    options.games = std::stoull(std::string(args[1]));
+    options.items = {config.foodCount, config.powerUps};
+    std::filesystem::path jsonPath;
+
+    for (std::size_t i = 2; i < args.size(); ++i)
+    {
+        if (args[i] == "--threads" && i + 1 < args.size())
+        {
+            options.threads = static_cast<unsigned int>(std::stoul(std::string(args[++i])));
+        }
+        else if (args[i] == "--policy" && i + 1 < args.size())
+        {
+            options.policy = policyFromName(args[++i]);
+        }
+        else if (args[i] == "--seed" && i + 1 < args.size())
+        {
+            options.seed = static_cast<std::uint32_t>(std::stoul(std::string(args[++i])));
+        }
+        else if (args[i] == "--max-ticks" && i + 1 < args.size())
+        {
+            options.maxTicks = std::stoull(std::string(args[++i]));
+        }
+        else if (args[i] == "--json" && i + 1 < args.size())
+        {
+            jsonPath = args[++i];
+        }
+        else
+        {
+            throw std::invalid_argument("Unknown simulate option: " + std::string(args[i]));
+        }
+    }
+
+    const MassResult result = runMassSimulation(makeBoard(config, dataDir), options);
+    const GameStats& stats = result.stats;
+    std::println("{} games in {:.2f} s on {} threads, score mean {:.2f} p50 {:.0f} p99 {:.0f} max {:.0f}",
+                 stats.games,
+                 result.seconds,
+                 result.threads,
+                 stats.scores.mean(),
+                 stats.scores.quantile(0.50),
+                 stats.scores.quantile(0.99),
+                 stats.scores.max());
+
+    if (!jsonPath.empty())
+    {
+        std::ofstream output(jsonPath, std::ios::trunc);
+        writeStatsJson(output, result, options);
+        if (!output)
+        {
+            throw std::runtime_error("Failed to write stats: " + jsonPath.string());
+        }
+    }
+    return 0;
+}
+
+// Turniej strategii: snake --tournament <strategia,strategia,...> [--min-games N] [--max-games N] [--ci W]
+// [--threads N] [--seed S] [--max-ticks T] [--json <plik>]
+int runTournamentMode(const std::vector<std::string_view>& args,
+                      const Config& config,
+                      const std::filesystem::path& dataDir)
+{
+    if (args.size() < 2)
+    {
+        throw std::invalid_argument("Usage: snake --tournament <policy,policy,...> [--min-games N] [--max-games N] "
+                                    "[--ci WIDTH] [--threads N] [--seed S] [--max-ticks T] [--json FILE]");
+    }
+
+    TournamentOptions options;
+    options.items = {config.foodCount, config.powerUps};
+    std::string_view names = args[1];
+    while (!names.empty())
+    {
+        const std::size_t comma = names.find(',');
+        options.policies.push_back(policyFromName(names.substr(0, comma)));
+        names = comma == std::string_view::npos ? std::string_view() : names.substr(comma + 1);
+    }
+    std::filesystem::path jsonPath;
+
+    for (std::size_t i = 2; i < args.size(); ++i)
+    {
+        if (args[i] == "--min-games" && i + 1 < args.size())
+        {
+            options.minGames = std::stoull(std::string(args[++i]));
+        }
+        else if (args[i] == "--max-games" && i + 1 < args.size())
+        {
+            options.maxGames = std::stoull(std::string(args[++i]));
+        }
+        else if (args[i] == "--ci" && i + 1 < args.size())
+        {
+            options.ciHalfWidth = std::stod(std::string(args[++i]));
+        }
+        else if (args[i] == "--threads" && i + 1 < args.size())
+        {
+            options.threads = static_cast<unsigned int>(std::stoul(std::string(args[++i])));
+        }
+        else if (args[i] == "--seed" && i + 1 < args.size())
+        {
+            options.seed = static_cast<std::uint32_t>(std::stoul(std::string(args[++i])));
+        }
+        else if (args[i] == "--max-ticks" && i + 1 < args.size())
+        {
+            options.maxTicks = std::stoull(std::string(args[++i]));
+        }
+        else if (args[i] == "--json" && i + 1 < args.size())
+        {
+            jsonPath = args[++i];
+        }
+        else
+        {
+            throw std::invalid_argument("Unknown tournament option: " + std::string(args[i]));
+        }
+    }
+
+    const TournamentResult result = runTournament(makeBoard(config, dataDir), options);
+    std::println("{} paired games{} in {:.2f} s on {} threads ({:.0f} games/s)",
+                 result.games,
+                 result.stoppedEarly ? " (stopped early)" : "",
+                 result.seconds,
+                 result.threads,
+                 result.seconds > 0.0 ? static_cast<double>(result.playedGames) / result.seconds : 0.0);
+    for (std::size_t i = 0; i < result.scores.size(); ++i)
+    {
+        std::println("  {:<8} {:8.2f} +- {:.2f}",
+                     policyName(options.policies[i]),
+                     result.scores[i].mean,
+                     result.scores[i].halfWidth);
+    }
+    for (const PairResult& pair : result.pairs)
+    {
+        std::println("  {} - {}: {:+.2f} +- {:.2f}",
+                     policyName(options.policies[pair.first]),
+                     policyName(options.policies[pair.second]),
+                     pair.difference.mean,
+                     pair.difference.halfWidth);
+    }
+
+    if (!jsonPath.empty())
+    {
+        std::ofstream output(jsonPath, std::ios::trunc);
+        writeTournamentJson(output, result, options);
+        if (!output)
+        {
+            throw std::runtime_error("Failed to write tournament report: " + jsonPath.string());
+        }
+    }
+    return 0;
+}
+
+// Widok wielu gier naraz: snake --spectate <gry> [--policy greedy|random|space] [--max-ticks T]
+int runSpectator(const std::vector<std::string_view>& args, const Config& config, const std::filesystem::path& dataDir)
+{
+    if (args.size() < 2)
+    {
+        throw std::invalid_argument("Usage: snake --spectate <games> [--policy greedy|random|space] [--max-ticks T]");
+    }
+
+    Policy policy = Policy::Greedy;
+    std::uint64_t maxTicks = 0;
+    for (std::size_t i = 2; i < args.size(); ++i)
+    {
+        if (args[i] == "--policy" && i + 1 < args.size())
+        {
+            policy = policyFromName(args[++i]);
+        }
+        else if (args[i] == "--max-ticks" && i + 1 < args.size())
+        {
+            maxTicks = std::stoull(std::string(args[++i]));
+        }
+        else
+        {
+            throw std::invalid_argument("Unknown spectate option: " + std::string(args[i]));
+        }
+    }
+
+    SpectatorView spectator(config, dataDir, std::stoi(std::string(args[1])), policy, maxTicks);
+    spectator.run();
+    return 0;
+}
+
+// Sterowanie botem: snake --bot [--socket <sciezka>] [--batch K]
+BotOptions parseBotOptions(const std::vector<std::string_view>& args, const Config& config)
+{
+    // Protokol zna tylko jedno jedzenie i wzrost o jedno pole, bez bonusow.
+    if (config.foodCount != 1 || config.powerUps != 0)
+    {
+        throw std::invalid_argument("--bot supports only food_count=1 and power_ups=0");
+    }
+
+    BotOptions options;
+    for (std::size_t i = 1; i < args.size(); ++i)
+    {
+        if (args[i] == "--socket" && i + 1 < args.size())
+        {
+            options.socket = args[++i];
+        }
+        else if (args[i] == "--batch" && i + 1 < args.size())
+        {
+            options.batch = std::stoi(std::string(args[++i]));
+        }
+        else
+        {
+            throw std::invalid_argument("Usage: snake --bot [--socket PATH] [--batch TICKS]");
+        }
+    }
+    return options;
+}
+
+// Zapisuje profil i os czasu przy kazdym wyjsciu z trybu, takze przez wyjatek,
+// zanim zniszcza sie bufory watku glownego.
+struct ProfilingFlush
+{
+    ProfilingFlush() = default;
+    ProfilingFlush(const ProfilingFlush&) = delete;
+    ProfilingFlush& operator=(const ProfilingFlush&) = delete;
+
+    ~ProfilingFlush()
+    {
+        PerfCounters::instance().flush();
+        Tracer::instance().flush();
+    }
+};
+} // namespace
+
+int main(int argc, char* argv[])
 {
     try
     {
         // Start gry i obsluga bledow konfiguracji.
         const std::filesystem::path dataDir = "data";
         const Config config = loadConfig(dataDir / "config.txt");
+        std::vector<std::string_view> args(argv, argv + argc);
+
+        const ProfilingFlush profilingFlush;
+
+        // Profil licznikow sprzetowych (--perf <raport>) i os czasu (--trace <plik.json>) przed trybem.
+        while (args.size() > 2 && (args[1] == "--perf" || args[1] == "--trace"))
+        {
+            if (args[1] == "--perf")
+            {
+                PerfCounters::instance().enable(args[2]);
+            }
+            else
+            {
+                Tracer::instance().enable(args[2]);
+            }
+            args.erase(args.begin() + 1, args.begin() + 3);
+        }
+
+        if (args.size() > 1 && args[1] == "--export")
+        {
+            const std::vector<std::string_view> exportArgs(args.begin() + 1, args.end());
+            return runExport(exportArgs, config, dataDir);
+        }
+
+        if (args.size() > 1 && args[1] == "--simulate")
+        {
+            return runSimulate(std::vector<std::string_view>(args.begin() + 1, args.end()), config, dataDir);
+        }
+
+        if (args.size() > 1 && args[1] == "--tournament")
+        {
+            return runTournamentMode(std::vector<std::string_view>(args.begin() + 1, args.end()), config, dataDir);
+        }
+
+        if (args.size() > 1 && args[1] == "--spectate")
+        {
+            return runSpectator(std::vector<std::string_view>(args.begin() + 1, args.end()), config, dataDir);
+        }
+
+        if (args.size() > 1 && args[1] == "--endless")
+        {
+            EndlessGame endless(config, dataDir);
+            endless.run();
+            return 0;
+        }
+
+        std::optional<BotOptions> bot;
+        if (args.size() > 1 && args[1] == "--bot")
+        {
+            bot = parseBotOptions(std::vector<std::string_view>(args.begin() + 1, args.end()), config);
+        }
 
-        Game game(config, dataDir);
+        Game game(config, dataDir, bot);
         game.run();
     }
     catch (const std::exception& ex)